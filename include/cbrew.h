@@ -1,6 +1,11 @@
 #ifndef CBREW_H
 #define CBREW_H
 
+// Only the declarations are needed when linking against the prebuilt libcbrew, even if CBREW_IMPLEMENTATION is defined
+#if defined(CBREW_DECLARATIONS_ONLY) && defined(CBREW_IMPLEMENTATION)
+#undef CBREW_IMPLEMENTATION
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
@@ -19,10 +24,11 @@ typedef uint8_t CbrewBool;
 
 /* Compiler detection */
 
-#ifdef __GNUC__
-#define CBREW_COMPILER "gcc"
-#elif defined(__clang__)
+// Clang defines __GNUC__ as well, so it has to be detected first
+#ifdef __clang__
 #define CBREW_COMPILER "clang"
+#elif defined(__GNUC__)
+#define CBREW_COMPILER "gcc"
 #else
 #error "Unsupported C compiler!"
 #endif
@@ -32,12 +38,22 @@ typedef uint8_t CbrewBool;
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
 #define CBREW_PLATFORM_WINDOWS
 #include <Windows.h>
+#include <io.h>
 #elif defined(__linux__) || defined(__gnu_linux__)
 #define CBREW_PLATFORM_LINUX
 #include <sys/stat.h>
 #include <limits.h>
 #include <unistd.h>
 #include <dirent.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#include <signal.h>
 #if defined(__ANDROID__)
 #define CBREW_PLATFORM_ANDROID
 #endif
@@ -200,10 +216,66 @@ typedef uint8_t CbrewBool;
 #define CBREW_PRJ_DEFINE(prj, define) cbrew_project_add_define(prj, define)
 #define CBREW_PRJ_FLAG(prj, flag) cbrew_project_add_flag(prj, flag)
 #define CBREW_PRJ_LINK(prj, link) cbrew_project_add_link(prj, link)
+#define CBREW_PRJ_INSTALL_HEADERS(prj, headers) cbrew_project_add_install_headers(prj, headers)
+#define CBREW_PRJ_FILE_FLAG(prj, files, flag) cbrew_project_add_file_flag(prj, files, flag, CBREW_FALSE)
+#define CBREW_PRJ_FILE_REMOVE_FLAG(prj, files, flag) cbrew_project_add_file_flag(prj, files, flag, CBREW_TRUE)
+#define CBREW_PRJ_TEST_TIMEOUT(prj, seconds) cbrew_project_set_test_timeout(prj, seconds)
+#define CBREW_PRJ_TEST_INPUTS(prj, inputs) cbrew_project_add_test_inputs(prj, inputs)
+#define CBREW_PRJ_BENCHMARK_SAMPLES(prj, samples) cbrew_project_set_benchmark_samples(prj, samples)
+#define CBREW_PRJ_BENCHMARK_THRESHOLDS(prj, warn_percent, fail_percent) cbrew_project_set_benchmark_thresholds(prj, warn_percent, fail_percent)
+#define CBREW_PRJ_STEP(prj, name, command) cbrew_project_add_step(prj, name, command)
+
+#define CBREW_STEP_INPUT(step, input) cbrew_step_add_input(step, input)
+#define CBREW_STEP_OUTPUT(step, output) cbrew_step_add_output(step, output)
 
 #define CBREW_CFG_NEW(prj, name, target_dir, obj_dir) cbrew_project_config_create(prj, name, target_dir, obj_dir)
 #define CBREW_CFG_DEFINE(cfg, define) cbrew_config_add_define(cfg, define)
 #define CBREW_CFG_FLAG(cfg, flag) cbrew_config_add_flag(cfg, flag)
+#define CBREW_CFG_INSTALL(cfg, install_dir) cbrew_config_set_install_dir(cfg, install_dir)
+#define CBREW_CFG_THIN_ARCHIVE(cfg) cbrew_config_set_thin_archive(cfg, CBREW_TRUE)
+#define CBREW_CFG_TOOLCHAIN(cfg, toolchain) cbrew_config_set_toolchain(cfg, toolchain)
+#define CBREW_CFG_FAST_LINK(cfg) cbrew_config_set_fast_link(cfg, CBREW_TRUE)
+#define CBREW_CFG_COMPRESS_DEBUG(cfg) cbrew_config_set_compress_debug_sections(cfg, CBREW_TRUE)
+
+#define CBREW_TOOLCHAIN_NEW(name, compiler) cbrew_toolchain_create(name, compiler)
+
+typedef struct CbrewArenaBlock
+{
+    struct CbrewArenaBlock* next;
+    size_t size;
+    size_t used;
+} CbrewArenaBlock;
+
+typedef struct CbrewArena
+{
+    CbrewArenaBlock* blocks;
+} CbrewArena;
+
+enum
+{
+    CBREW_TOOLCHAIN_CAPABILITY_DEPFILES = 1 << 0,
+    CBREW_TOOLCHAIN_CAPABILITY_LLD = 1 << 1,
+    CBREW_TOOLCHAIN_CAPABILITY_MOLD = 1 << 2,
+    CBREW_TOOLCHAIN_CAPABILITY_GOLD = 1 << 3,
+    CBREW_TOOLCHAIN_CAPABILITY_SPLIT_DWARF = 1 << 4,
+    CBREW_TOOLCHAIN_CAPABILITY_LTO = 1 << 5,
+    CBREW_TOOLCHAIN_CAPABILITY_COMPRESS_DEBUG_SECTIONS = 1 << 6
+};
+
+typedef uint32_t CbrewToolchainCapabilities;
+
+typedef struct CbrewToolchain
+{
+    const char* name;
+
+    const char* compiler;
+    const char* archiver;
+    const char* linker;
+    const char* launcher;
+
+    CbrewToolchainCapabilities capabilities;
+    CbrewBool probed;
+} CbrewToolchain;
 
 typedef struct CbrewConfig
 {
@@ -211,12 +283,21 @@ typedef struct CbrewConfig
 
     const char* target_dir;
     const char* obj_dir;
+    const char* install_dir;
+
+    CbrewBool thin_archive;
+    CbrewBool fast_link;
+    CbrewBool compress_debug_sections;
 
-    char** defines;
+    CbrewToolchain* toolchain;
+
+    const char** defines;
     size_t defines_count;
+    size_t defines_capacity;
 
-    char** flags;
+    const char** flags;
     size_t flags_count;
+    size_t flags_capacity;
 } CbrewConfig;
 
 enum
@@ -224,41 +305,476 @@ enum
     CBREW_PROJECT_TYPE_APP = 0,
     CBREW_PROJECT_TYPE_STATIC_LIB,
     CBREW_PROJECT_TYPE_DYNAMIC_LIB,
+    CBREW_PROJECT_TYPE_TEST,
+    CBREW_PROJECT_TYPE_BENCHMARK,
 
     CBREW_PROJECT_TYPE_SIZE
 };
 
 typedef uint8_t CbrewProjectType;
 
+typedef struct CbrewFileFlag
+{
+    const char* wildcard;
+    const char* flag;
+    CbrewBool remove;
+} CbrewFileFlag;
+
+typedef struct CbrewStep
+{
+    const char* name;
+    const char* command;
+
+    const char** inputs;
+    size_t inputs_count;
+    size_t inputs_capacity;
+
+    const char** outputs;
+    size_t outputs_count;
+    size_t outputs_capacity;
+} CbrewStep;
+
 typedef struct CbrewProject
 {
     const char* name;
     CbrewProjectType type;
 
-    char** wildcards;
+    const char** wildcards;
     size_t wildcards_count;
+    size_t wildcards_capacity;
 
-    char** include_dirs;
+    const char** include_dirs;
     size_t include_dirs_count;
+    size_t include_dirs_capacity;
 
-    char** defines;
+    const char** defines;
     size_t defines_count;
+    size_t defines_capacity;
 
-    char** flags;
+    const char** flags;
     size_t flags_count;
+    size_t flags_capacity;
 
-    char** links;
+    CbrewFileFlag* file_flags;
+    size_t file_flags_count;
+    size_t file_flags_capacity;
+
+    const char** links;
     size_t links_count;
+    size_t links_capacity;
+
+    const char** install_headers;
+    size_t install_headers_count;
+    size_t install_headers_capacity;
+
+    size_t test_timeout;
+
+    const char** test_inputs;
+    size_t test_inputs_count;
+    size_t test_inputs_capacity;
 
-    CbrewConfig* configs;
+    size_t benchmark_samples;
+    double benchmark_warn_threshold;
+    double benchmark_fail_threshold;
+
+    CbrewStep** steps;
+    size_t steps_count;
+    size_t steps_capacity;
+
+    CbrewConfig** configs;
     size_t configs_count;
+    size_t configs_capacity;
 } CbrewProject;
 
+enum
+{
+    CBREW_ACTION_TYPE_COMPILE = 0,
+    CBREW_ACTION_TYPE_LINK,
+    CBREW_ACTION_TYPE_STATIC_LIB,
+    CBREW_ACTION_TYPE_DYNAMIC_LIB,
+    CBREW_ACTION_TYPE_INSTALL,
+    CBREW_ACTION_TYPE_SHARE,
+    CBREW_ACTION_TYPE_TEST,
+    CBREW_ACTION_TYPE_BENCHMARK,
+    CBREW_ACTION_TYPE_STEP,
+
+    CBREW_ACTION_TYPE_SIZE
+};
+
+typedef uint8_t CbrewActionType;
+
+enum
+{
+    CBREW_ACTION_STATE_PENDING = 0,
+    CBREW_ACTION_STATE_RUNNING,
+    CBREW_ACTION_STATE_SUCCEEDED,
+    CBREW_ACTION_STATE_FAILED,
+    CBREW_ACTION_STATE_SKIPPED,
+    CBREW_ACTION_STATE_UP_TO_DATE,
+
+    CBREW_ACTION_STATE_SIZE
+};
+
+typedef uint8_t CbrewActionState;
+
+enum
+{
+    CBREW_CLEAN_MODE_NONE = 0,
+    CBREW_CLEAN_MODE_STALE,
+    CBREW_CLEAN_MODE_ALL,
+
+    CBREW_CLEAN_MODE_SIZE
+};
+
+typedef uint8_t CbrewCleanMode;
+
+typedef struct CbrewStringBuilder
+{
+    char* data;
+    size_t len;
+    size_t capacity;
+} CbrewStringBuilder;
+
+typedef struct CbrewConfigArgs
+{
+    const CbrewProject* project;
+    const CbrewConfig* config;
+    const CbrewToolchain* toolchain;
+    CbrewBool split_dwarf;
+
+    char* compile_args;
+    char* link_args;
+    char* dynamic_lib_args;
+    char* links;
+
+    CbrewStringBuilder obj_files;
+} CbrewConfigArgs;
+
+typedef struct CbrewAction
+{
+    CbrewActionType type;
+    CbrewActionState state;
+
+    const CbrewProject* project;
+    const CbrewConfig* config;
+    const CbrewConfigArgs* args;
+    const CbrewStep* step;
+
+    char* input;
+    char* destination;
+    char* compile_args;
+    CbrewBool split_dwarf;
+
+    size_t* dependencies;
+    size_t dependencies_count;
+
+    double start_time;
+    double end_time;
+    double deadline;
+
+    size_t estimated_memory_kb;
+    size_t peak_memory_kb;
+
+    double estimated_duration;
+    double critical_path;
+
+    uint64_t signature;
+
+    char* output;
+} CbrewAction;
+
+typedef struct CbrewGraph
+{
+    CbrewAction* actions;
+    size_t actions_count;
+
+    CbrewConfigArgs** config_args;
+    size_t config_args_count;
+} CbrewGraph;
+
+typedef struct CbrewProcess
+{
+#ifdef CBREW_PLATFORM_WINDOWS
+    HANDLE handle;
+    HANDLE job;
+#else
+    pid_t pid;
+    int output_fd;
+    CbrewBool group;
+#endif
+
+    CbrewStringBuilder output;
+} CbrewProcess;
+
+typedef struct CbrewHistoryEntry
+{
+    char* key;
+
+    size_t peak_memory_kb;
+    double duration;
+    uint64_t signature;
+} CbrewHistoryEntry;
+
+typedef struct CbrewHistory
+{
+    CbrewHistoryEntry* entries;
+    size_t entries_count;
+    size_t entries_capacity;
+} CbrewHistory;
+
+typedef struct CbrewBenchmarkMetric
+{
+    char name[64];
+    char unit[16];
+
+    double* samples;
+    size_t samples_count;
+    size_t samples_capacity;
+} CbrewBenchmarkMetric;
+
+typedef struct CbrewStatsRecord
+{
+    uint64_t time;
+    CbrewBool success;
+    double wall_time;
+
+    size_t actions_count;
+    size_t run_count;
+    size_t up_to_date_count;
+    size_t failed_count;
+    size_t skipped_count;
+    size_t peak_memory_kb;
+
+    const char* configs;
+    const char* selection;
+} CbrewStatsRecord;
+
+typedef struct CbrewIncludeCacheEntry
+{
+    char* key;
+
+    uint64_t mtime;
+    char* includes;
+} CbrewIncludeCacheEntry;
+
+typedef struct CbrewIncludeCache
+{
+    CbrewIncludeCacheEntry* entries;
+    size_t entries_count;
+    size_t entries_capacity;
+} CbrewIncludeCache;
+
+typedef struct CbrewJobserver
+{
+    CbrewBool active;
+    CbrewBool server;
+    CbrewBool unavailable;
+
+    int read_fd;
+    int write_fd;
+
+    char* tokens;
+    size_t tokens_count;
+    size_t tokens_capacity;
+} CbrewJobserver;
+
 /**
 * Builds all projects with all configurations that have been registered with cbrew.
+* The actions of all projects are run concurrently, but a product is only created after the products of the library configs that its project links.
+* Afterwards, all projects and configs are freed by calling cbrew_free().
+* If anything fails, e.g. a compile or a test, the process exits with EXIT_FAILURE, so scripts and the cbrew executable notice the failure.
 */
 void cbrew_build(void);
 
+/**
+* Frees all projects, configs and strings that have been registered with cbrew at once.
+* Every pointer to a project or config becomes invalid.
+*/
+void cbrew_free(void);
+
+/**
+* Sets the maximum amount of actions (e.g. compiling a source file) that cbrew runs at the same time.
+* @param jobs The maximum amount of simultaneous actions. A value of 0 restores the default.
+*/
+void cbrew_set_jobs(size_t jobs);
+
+/**
+* Retrieves the maximum amount of actions that cbrew runs at the same time.
+* @return Returns the value set by cbrew_set_jobs, the value of the CBREW_JOBS environment variable or the amount of available processors, in that order.
+*/
+size_t cbrew_get_jobs(void);
+
+/**
+* Sets the maximum amount of memory that all running actions may use together, based on the peak memory usage of previous builds.
+* An action is always started when no other action is running, even if it exceeds the limit.
+* @param megabytes The memory limit in megabytes. A value of 0 restores the default.
+*/
+void cbrew_set_memory_limit(size_t megabytes);
+
+/**
+* Retrieves the maximum amount of memory that all running actions may use together.
+* @return Returns the value set by cbrew_set_memory_limit, the value of the CBREW_MEMORY_LIMIT environment variable in megabytes or 0, in that order. A value of 0 means that the memory which is available when the build starts is used as the limit.
+*/
+size_t cbrew_get_memory_limit(void);
+
+/**
+* Sets the system load average above which no additional actions are started.
+* @param load The maximum load average. A value of 0 disables the limit.
+*/
+void cbrew_set_load_limit(double load);
+
+/**
+* Retrieves the system load average above which no additional actions are started.
+* @return Returns the value set by cbrew_set_load_limit, the value of the CBREW_LOAD_LIMIT environment variable or 0, in that order. A value of 0 means that there is no limit.
+*/
+double cbrew_get_load_limit(void);
+
+/**
+* Sets whether the build keeps going after an action failed.
+* If enabled, every action that doesn't depend on a failed action is still run, otherwise the remaining actions of the failed config are skipped.
+* @param keep_going CBREW_TRUE to keep going after failures, CBREW_FALSE otherwise.
+*/
+void cbrew_set_keep_going(CbrewBool keep_going);
+
+/**
+* Retrieves whether the build keeps going after an action failed.
+* @return Returns CBREW_TRUE if the build keeps going after failures, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_get_keep_going(void);
+
+/**
+* Sets whether the build only logs the actions it would run, without running them or creating any directories.
+* @param dry_run CBREW_TRUE to only log the actions, CBREW_FALSE to run them.
+*/
+void cbrew_set_dry_run(CbrewBool dry_run);
+
+/**
+* Retrieves whether the build only logs the actions it would run.
+* @return Returns CBREW_TRUE if actions are only logged, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_get_dry_run(void);
+
+/**
+* Sets whether the build logs why every action is run or skipped, e.g. because a header is newer than the object file.
+* @param explain CBREW_TRUE to log the reason of every action, CBREW_FALSE otherwise.
+*/
+void cbrew_set_explain(CbrewBool explain);
+
+/**
+* Retrieves whether the build logs why every action is run or skipped.
+* @return Returns CBREW_TRUE if the reason of every action is logged, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_get_explain(void);
+
+/**
+* Sets whether files that are no longer created by any action, e.g. the object files of deleted source files, are deleted at the end of every build.
+* @param prune_stale CBREW_TRUE to delete stale files, CBREW_FALSE to keep them.
+*/
+void cbrew_set_prune_stale(CbrewBool prune_stale);
+
+/**
+* Retrieves whether stale files are deleted at the end of every build.
+* @return Returns CBREW_TRUE if stale files are deleted, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_get_prune_stale(void);
+
+/**
+* Sets whether cbrew_build() deletes files instead of building, like "cbrew clean" does.
+* @param clean_mode CBREW_CLEAN_MODE_NONE to build, CBREW_CLEAN_MODE_STALE to only delete stale files, or CBREW_CLEAN_MODE_ALL to delete every created file.
+*/
+void cbrew_set_clean_mode(CbrewCleanMode clean_mode);
+
+/**
+* Retrieves whether cbrew_build() deletes files instead of building.
+* @return Returns the clean mode set by cbrew_set_clean_mode() or the command line arguments.
+*/
+CbrewCleanMode cbrew_get_clean_mode(void);
+
+/**
+* Sets whether cbrew_build() runs the tests of all test projects after building them, like "cbrew test" does.
+* @param run_tests CBREW_TRUE to run the tests, CBREW_FALSE to only build them.
+*/
+void cbrew_set_run_tests(CbrewBool run_tests);
+
+/**
+* Retrieves whether cbrew_build() runs the tests of all test projects.
+* @return Returns CBREW_TRUE if the tests are run, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_get_run_tests(void);
+
+/**
+* Sets whether cbrew_build() runs the benchmarks of all benchmark projects after building them, like "cbrew bench" does.
+* @param run_benchmarks CBREW_TRUE to run the benchmarks, CBREW_FALSE to only build them.
+*/
+void cbrew_set_run_benchmarks(CbrewBool run_benchmarks);
+
+/**
+* Retrieves whether cbrew_build() runs the benchmarks of all benchmark projects.
+* @return Returns CBREW_TRUE if the benchmarks are run, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_get_run_benchmarks(void);
+
+/**
+* Restricts the tests that are built and run to one of several shards, e.g. to split the tests across multiple machines.
+* Every test is assigned to a shard by the hash of its filepath, so the assignment doesn't change when other tests are added.
+* @param index The 1-based index of the shard to build and run.
+* @param count The amount of shards, or 0 to build and run all tests.
+*/
+void cbrew_set_shard(size_t index, size_t count);
+
+/**
+* Restricts cbrew_build() to a project and the projects it links against, like "cbrew build <target>" does. Without any target, every project is built.
+* @param target The name of the project, optionally followed by ":" and the name of the only config to build, e.g. "Foo:Release".
+*/
+void cbrew_add_target(const char* target);
+
+/**
+* Selects the configs that the targets and the products they link against require.
+* @return Returns CBREW_TRUE if every target names an existing project and config, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_select_targets(void);
+
+/**
+* Checks whether a config is built, i.e. whether no targets are set or the config has been selected by cbrew_select_targets().
+* @param config The config to check.
+* @return Returns CBREW_TRUE if the config is built, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_config_is_selected(const CbrewConfig* config);
+
+/**
+* Finds the config whose product is linked by a link of a project.
+* @param link The link, which is the path of the product without its prefix and extension.
+* @return Returns the config creating the product, or NULL if the product isn't created by any config.
+*/
+const CbrewConfig* cbrew_link_find_config(const char* link);
+
+/**
+* Checks whether a test belongs to the shard that is built and run.
+* @param filepath The filepath of the test's source file.
+* @return Returns CBREW_TRUE if no shard is set or the test belongs to the shard, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_file_is_in_shard(const char* filepath);
+
+/**
+* Parses the command line arguments of the local cbrew executable, e.g. "-k" to keep going after failures.
+* The arguments are parsed only once, so calling this function multiple times has no further effect.
+*/
+void cbrew_parse_args(void);
+
+/**
+* Logs which action is started and how many actions have been started so far, e.g. "[12/40] compiling foo/bar.c".
+* On an interactive console, the progress replaces the previously logged progress, otherwise every progress is logged on its own line.
+* @param current The number of actions that have been started, including this one.
+* @param total The number of all actions.
+* @param action The action that is started.
+*/
+void cbrew_log_progress(size_t current, size_t total, const CbrewAction* action);
+
+/**
+* Removes the progress from an interactive console, so other messages can be logged.
+*/
+void cbrew_log_progress_clear(void);
+
 /* Projects */
 
 /**
@@ -304,6 +820,100 @@ void cbrew_project_add_include_dir(CbrewProject* project, const char* include_di
 */
 void cbrew_project_add_link(CbrewProject* project, const char* link);
 
+/**
+* Adds headers that are installed together with the product of every config that has an install directory.
+* The headers are installed into the include directory of the install directory, keeping their path relative to the directory of the wildcard.
+* @param project The project to which the headers will be added.
+* @param wildcard The wildcard that must be matched for a header to be installed.
+*/
+void cbrew_project_add_install_headers(CbrewProject* project, const char* wildcard);
+
+/**
+* Adds a flag to, or removes a flag from, the source files of the project that match a wildcard, e.g. "-O3" for the hot source files of a project.
+* Added flags come after the flags of the project and its configs, so they take precedence. Removed flags are removed from all of these flags.
+* @param project The project whose source files will be compiled with the flag.
+* @param wildcard The wildcard that the source files must match.
+* @param flag The flag to add or remove, which must include the single or double hyphen.
+* @param remove CBREW_TRUE to remove the flag, CBREW_FALSE to add it.
+*/
+void cbrew_project_add_file_flag(CbrewProject* project, const char* wildcard, const char* flag, CbrewBool remove);
+
+/**
+* Sets how long a single test of a test project may run before it is stopped and counts as failed.
+* @param project The test project whose tests will be limited.
+* @param seconds The time limit in seconds, or 0 to let tests run as long as they need. The default limit is 300 seconds.
+*/
+void cbrew_project_set_test_timeout(CbrewProject* project, size_t seconds);
+
+/**
+* Adds files that the tests of a test project read, e.g. test data, so changing them runs the tests again.
+* @param project The test project whose tests read the files.
+* @param wildcard The wildcard that the files must match.
+*/
+void cbrew_project_add_test_inputs(CbrewProject* project, const char* wildcard);
+
+/**
+* Sets how often every benchmark of a benchmark project is run. Every metric is summarized over all of these samples.
+* @param project The benchmark project whose benchmarks will be sampled.
+* @param samples The amount of samples, which must be at least 1. The default is 10 samples.
+*/
+void cbrew_project_set_benchmark_samples(CbrewProject* project, size_t samples);
+
+/**
+* Sets how much slower the median of a benchmark metric may become compared to its baseline, before a warning is logged or the benchmark fails.
+* @param project The benchmark project whose benchmarks will be compared.
+* @param warn_percent The regression in percent that logs a warning, or 0 to never warn. The default is 5 percent.
+* @param fail_percent The regression in percent that fails the benchmark, or 0 to never fail. By default, benchmarks never fail because of a regression.
+*/
+void cbrew_project_set_benchmark_thresholds(CbrewProject* project, double warn_percent, double fail_percent);
+
+/**
+* Checks whether a source file matches the wildcard of a file flag.
+* Wildcards without a leading "./" match source files inside the current directory as well.
+* @param file_flag The file flag whose wildcard will be checked.
+* @param filepath The filepath of the source file.
+* @return Returns CBREW_TRUE if the file flag applies to the source file, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_file_flag_matches(const CbrewFileFlag* file_flag, const char* filepath);
+
+/**
+* Checks whether any flag of the project is added to or removed from a given source file.
+* @param project The project that the source file belongs to.
+* @param filepath The filepath of the source file.
+* @return Returns CBREW_TRUE if the source file has its own flags, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_project_file_has_flags(const CbrewProject* project, const char* filepath);
+
+/**
+* Collects the flags that compile a source file of a config, i.e. the flags of the project and config, plus the flags added to the file, minus the flags removed from it.
+* @param project The project that the source file belongs to.
+* @param config The config that compiles the source file.
+* @param filepath The filepath of the source file, or NULL to only collect the flags of the project and config.
+* @param flags_count A pointer whose value will be set to the element count of the returned array.
+* @return Returns the flags in the order in which they are passed to the compiler. The array must be freed by the caller, but not its elements.
+*/
+const char** cbrew_project_config_flags(const CbrewProject* project, const CbrewConfig* config, const char* filepath, size_t* flags_count);
+
+/**
+* Checks whether a source file of a config is compiled with split debug information, which requires fast linking, a toolchain that supports it and debug information after the flags of the file have been applied.
+* @param project The project that the source file belongs to.
+* @param config The config that compiles the source file.
+* @param toolchain The probed toolchain of the config.
+* @param filepath The filepath of the source file, or NULL to only use the flags of the project and config.
+* @return Returns CBREW_TRUE if the debug information is split into a .dwo file, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_project_config_splits_dwarf(const CbrewProject* project, const CbrewConfig* config, const CbrewToolchain* toolchain, const char* filepath);
+
+/**
+* Creates the arguments that compile a source file of a config, i.e. its include directories, flags and defines.
+* @param project The project that the source file belongs to.
+* @param config The config that compiles the source file.
+* @param filepath The filepath of the source file, whose flags are added and removed, or NULL to only use the flags of the project and config.
+* @param split_dwarf CBREW_TRUE to split the debug information into a .dwo file.
+* @return Returns the compile arguments, which end with a whitespace if they aren't empty. This string must be freed by the caller.
+*/
+char* cbrew_project_config_compile_args(const CbrewProject* project, const CbrewConfig* config, const char* filepath, CbrewBool split_dwarf);
+
 /**
 * Checks whether or not the specified filepath is a source file that belongs to the specified project.
 * @param project The project whose wildcards are used to match against the filepath.
@@ -312,6 +922,14 @@ void cbrew_project_add_link(CbrewProject* project, const char* link);
 */
 CbrewBool cbrew_project_file_matches_wildcards(const CbrewProject* project, const char* filepath);
 
+/**
+* Checks whether or not the specified filepath is created by one of the build steps of the specified project.
+* @param project The project whose build steps are checked.
+* @param filepath The filepath which is compared with the outputs of the build steps.
+* @return Returns CBREW_TRUE if any build step of the project creates the filepath, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_project_file_is_step_output(const CbrewProject* project, const char* filepath);
+
 /**
 * Constructs a string array consisting of all source files for the specified project.
 * @param project The project whose source files will be found.
@@ -322,20 +940,100 @@ char** cbrew_project_find_source_files(const CbrewProject* project, size_t* file
 
 /**
 * Builds the project with every config of the project, which includes compilation and linkage.
+* The configs are built concurrently.
 * @param project The project to build.
 * @return Returns CBREW_TRUE on success, CBREW_FALSE otherwise.
 */
 CbrewBool cbrew_project_build(const CbrewProject* project);
 
+/**
+* Adds the actions to build the project with every config of the project to an action graph.
+* The source files of the project are only searched once and shared by all configs.
+* @param graph The graph to which the actions will be added.
+* @param project The project whose actions will be added.
+* @return Returns CBREW_TRUE if the actions were added or the project was skipped, CBREW_FALSE if the project can't be built.
+*/
+CbrewBool cbrew_project_add_actions(CbrewGraph* graph, const CbrewProject* project);
+
+/**
+* Adds the actions to build the project with the specified config to an action graph.
+* This consists of one compile action per source file and one action creating the final product, which depends on all compile actions.
+* @param graph The graph to which the actions will be added.
+* @param project The project to build.
+* @param config The config to build the project with.
+* @param project_files A string array containing the source files of the project.
+* @param project_files_count The count of the project's source files.
+* @return Returns the index of the action creating the final product.
+*/
+size_t cbrew_project_config_add_actions(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, char** project_files, size_t project_files_count);
+
+/**
+* Adds the actions to install the product of a config and the headers of its project to an action graph.
+* @param graph The graph to which the actions will be added.
+* @param project The project whose headers will be installed.
+* @param config The config whose install directory is used.
+* @param final_action The index of the action creating the product, which the install action of the product depends on.
+*/
+void cbrew_project_config_add_install_actions(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, size_t final_action);
+
+/**
+* Logs the results of building the project with every config of the project.
+* @param graph The graph whose actions built the project.
+* @param project The project that was built.
+* @return Returns CBREW_TRUE if every action of the project succeeded, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_project_log_result(const CbrewGraph* graph, const CbrewProject* project);
+
+/**
+* Logs the result of building the project with the specified config.
+* @param graph The graph whose actions built the project.
+* @param project The project that was built.
+* @param config The config that the project was built with.
+* @return Returns CBREW_TRUE if every action of the config succeeded, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_project_config_log_result(const CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config);
+
 /**
 * Checks whether an object file alreadys exists for a given source file and checks whether or not the object file is still up to date.
 * @param project The project that is compiled.
 * @param config The config that is compiled with.
 * @param filepath The filepath of the source file.
-* @return Returns CBREW_TRUE if there is already an up to date object file for the specified source file, CBREW_FALSE otherwise or if the executable was rebuilt after the compilation of the object file.
+* @return Returns CBREW_TRUE if there is already an object file for the specified source file which is newer than the source file and all headers it includes, CBREW_FALSE otherwise.
 */
 CbrewBool cbrew_project_config_file_is_already_compiled(const CbrewProject* project, const CbrewConfig* config, const char* filepath);
 
+/**
+* Retrieves the make rule that lists the headers a source file depends on.
+* The rule is read from the dependency file written while compiling, otherwise it is created by cbrew_project_scan_dependencies().
+* @param project The project that is compiled.
+* @param config The config that is compiled with.
+* @param filepath The filepath of the source file.
+* @return Returns the make rule of the object file, or NULL if it couldn't be created. This string must be freed by the caller.
+*/
+char* cbrew_project_config_file_dependencies(const CbrewProject* project, const CbrewConfig* config, const char* filepath);
+
+/**
+* Finds the source file and all headers it includes, directly or indirectly, without starting the preprocessor.
+* Included headers are searched next to the including file (only for quoted includes) and inside the include directories of the project, while headers that can't be found, like system headers, are ignored.
+* Every #include is followed regardless of conditional compilation, so the result may contain more headers than the compiler would include.
+* @param project The project whose include directories are searched.
+* @param filepath The filepath of the source file.
+* @return Returns the source file followed by all included headers, separated by spaces, or NULL if the source file doesn't exist. This string must be freed by the caller.
+*/
+char* cbrew_project_scan_dependencies(const CbrewProject* project, const char* filepath);
+
+/**
+* Records every file that the actions of a config create inside the manifest of the config, and deletes the files that are no longer created.
+* Files are stale if a previous build recorded them, but no action of the graph creates them anymore, e.g. the object file of a deleted source file.
+* The outputs of build steps are recorded by the first config of the project only, no matter which configs are built, and are never stale for any config.
+* @param graph The graph containing the actions of the config.
+* @param project The project of the config.
+* @param config The config whose manifest will be updated.
+* @param clean_mode CBREW_CLEAN_MODE_NONE to keep stale files, CBREW_CLEAN_MODE_STALE to delete them, or CBREW_CLEAN_MODE_ALL to delete every recorded file and the manifest itself.
+* @return Returns the number of deleted files.
+*/
+size_t cbrew_project_config_update_manifest(const CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, CbrewCleanMode clean_mode);
+
 /**
 * Compiles a project with the specified config into object files.
 * @param project The project to build.
@@ -370,11 +1068,62 @@ CbrewBool cbrew_project_config_compile_dynamic_lib(const CbrewProject* project,
 */
 CbrewBool cbrew_project_config_link(const CbrewProject* project, const CbrewConfig* config);
 
-/* Configs */
+/* Build steps */
 
 /**
-* Creates a new config for a given project.
-* @param project The project for which the config is created.
+* Adds a custom command to a project, e.g. a code generator, which is run before the source files of the project are compiled.
+* The command is only run again if one of its outputs is missing, one of its inputs has changed or the command itself has changed.
+* Outputs that match the wildcards of the project are compiled like any other source file of the project, even before they exist.
+* @param project The project that uses the outputs of the command.
+* @param name The name of the step, which is logged while its command runs.
+* @param command The command to run. It is run once per build, not once per config.
+* @return Returns the created step.
+*/
+CbrewStep* cbrew_project_add_step(CbrewProject* project, const char* name, const char* command);
+
+/**
+* Adds a file that the command of a step reads. If the input is an output of another step of the project, the steps run one after another.
+* @param step The step whose command reads the file.
+* @param wildcard The wildcard that the files must match.
+*/
+void cbrew_step_add_input(CbrewStep* step, const char* wildcard);
+
+/**
+* Adds a file that the command of a step creates. The directory of the file is created before the command runs.
+* @param step The step whose command creates the file.
+* @param filepath The filepath of the file.
+*/
+void cbrew_step_add_output(CbrewStep* step, const char* filepath);
+
+/**
+* Converts a path relative to the working directory into the form of the paths of found source files, which start with "./".
+* @param source_path A string large enough to store the converted path.
+* @param path The path to convert. Absolute paths and paths starting with "." are only converted to the path separator of the platform.
+*/
+void cbrew_source_path(char* source_path, const char* path);
+
+/**
+* Converts a path into a form that can be compared with other paths, i.e. a source path without empty or "." components in between and without trailing path separators.
+* @param normalized_path A string large enough to store the converted path.
+* @param path The path to convert, e.g. "bin//Foo-Debug/./Foo/", which becomes "./bin/Foo-Debug/Foo".
+*/
+void cbrew_normalized_path(char* normalized_path, const char* path);
+
+/**
+* Adds the action of a build step to an action graph.
+* @param graph The graph to which the action will be added.
+* @param project The project that the step belongs to.
+* @param config The first config of the project that is built. Steps are shared by all configs, so they are reported as part of this config.
+* @param step The step whose command the action runs.
+* @return Returns the index of the action.
+*/
+size_t cbrew_graph_add_step_action(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, const CbrewStep* step);
+
+/* Configs */
+
+/**
+* Creates a new config for a given project.
+* @param project The project for which the config is created.
 * @param name The name of the config.
 * @param target_dir The path to the target directory of the config.
 * @param obj_dir The path to the object directory of the config.
@@ -397,1229 +1146,7693 @@ void cbrew_config_add_flag(CbrewConfig* config, const char* flag);
 void cbrew_config_add_define(CbrewConfig* config, const char* define);
 
 /**
-* Creates a string which contains all object files inside the config's object directory.
-* @param config The config of which the object files inside the object directory should be retrieved.
-* @return Returns a string which contains all object files inside the config's object directory. This string must be freed by the caller.
+* Sets the directory into which the product of the config is installed after building it, e.g. a staging prefix.
+* Executables are installed into its bin directory, libraries into its lib directory and the headers of the project into its include directory.
+* Only files that have changed since they were installed last are installed again.
+* @param config The config whose product will be installed.
+* @param install_dir The path to the install directory, or NULL to not install the product.
 */
-char* cbrew_config_create_obj_files_str(const CbrewConfig* config);
-
-/* Util */
+void cbrew_config_set_install_dir(CbrewConfig* config, const char* install_dir);
 
 /**
-* Converts any string to a valid path string for the current system by replacing every '/' character with the CBREW_PATH_SEPARATOR character.
-* @param path The path to convert.
-* @return Returns the modified string.
+* Sets whether the static library of the config is created as a thin archive, which references its object files instead of containing copies of them.
+* Thin archives are cheap to update, but can only be used as long as the object files exist.
+* @param config The config whose static library will be created.
+* @param thin_archive CBREW_TRUE to create a thin archive, CBREW_FALSE to create a regular archive.
 */
-char* cbrew_path(char* path);
+void cbrew_config_set_thin_archive(CbrewConfig* config, CbrewBool thin_archive);
 
 /**
-* Creates a string which contains all elements of the specicfied array.
-* The individual strings are separated by a whitespace.
-* @param flags The string array containing the flags.
-* @param flags_count The element count of flags.
-* @return Returns a string which contains all elements of flags. This string must be freed by the caller.
+* Sets the toolchain that builds the config.
+* The toolchain can be overridden for all configs with the "--toolchain=<name>" argument.
+* @param config The config that will be built with the toolchain.
+* @param toolchain The toolchain to use, or NULL to use the default toolchain.
 */
-char* cbrew_create_flags_str(char** flags, size_t flags_count);
+void cbrew_config_set_toolchain(CbrewConfig* config, CbrewToolchain* toolchain);
 
 /**
-* Creates a string which contains all elements of the specicfied array.
-* "-D" will be inserted before every define.
-* The individual strings are separated by a whitespace.
-* @param defines The string array containing the defines.
-* @param defines_count The element count of defines.
-* @return Returns a string which contains all elements of defines. This string must be freed by the caller.
+* Sets whether the products of the config are linked as fast as possible.
+* Unless the toolchain names a linker, mold, lld or gold is used if the compiler supports one of them.
+* If the config is compiled with debug information, the debug information stays inside .dwo files next to the object files, so the linker doesn't need to copy it.
+* Features that the toolchain doesn't support are left out, so the config is still built with the default linker.
+* @param config The config whose products will be linked.
+* @param fast_link CBREW_TRUE to link as fast as possible, CBREW_FALSE to link as usual.
 */
-char* cbrew_create_defines_str(char** defines, size_t defines_count);
+void cbrew_config_set_fast_link(CbrewConfig* config, CbrewBool fast_link);
 
 /**
-* Creates a string which contains all elements of the specicfied array.
-* "-L" will be inserted before every include directory.
-* The individual strings are separated by a whitespace.
-* @param include_dirs The string array containing the include_dirs.
-* @param include_dirs_count The element count of include_dirs.
-* @return Returns a string which contains all elements of include_dirs. This string must be freed by the caller.
+* Sets whether the linker compresses the debug sections of the products of the config, which makes them smaller, but is slower to link.
+* The debug sections stay uncompressed if the linker doesn't support compressing them.
+* @param config The config whose products will be linked.
+* @param compress_debug_sections CBREW_TRUE to compress the debug sections, CBREW_FALSE to keep them uncompressed.
 */
-char* cbrew_create_include_dirs_str(char** include_dirs, size_t include_dirs_count);
+void cbrew_config_set_compress_debug_sections(CbrewConfig* config, CbrewBool compress_debug_sections);
 
 /**
-* Creates a string which contains all elements of the specicfied array.
-* "-l" will be inserted before every link.
-* The individual strings are separated by a whitespace.
-* @param links The string array containing the links.
-* @param links_count The element count of links.
-* @return Returns a string which contains all elements of links. This string must be freed by the caller.
+* Retrieves the toolchain that builds the config, which is either selected by the command line arguments, the config or the default toolchain.
+* @param config The config whose toolchain will be retrieved.
+* @return Returns the toolchain of the config.
 */
-char* cbrew_create_links_str(char** links, size_t links_count);
+CbrewToolchain* cbrew_config_toolchain(const CbrewConfig* config);
 
-/* IO */
+/**
+* Retrieves the path of the object file for a given source file.
+* @param obj_filepath A string large enough to store the object filepath.
+* @param config The config whose object directory contains the object file.
+* @param filepath The filepath of the source file.
+*/
+void cbrew_config_obj_filepath(char* obj_filepath, const CbrewConfig* config, const char* filepath);
 
 /**
-* Copies the filepath inside argv[0] into filepath with the correct extension, if the extension of the executable is not already inside argv[0].
-* @param filepath A string large enough to store the filepath.
+* Retrieves the path of the dependency file, which lists the headers that a given source file includes.
+* @param dep_filepath A string large enough to store the dependency filepath.
+* @param config The config whose object directory contains the dependency file.
+* @param filepath The filepath of the source file.
 */
-void cbrew_executable_filepath(char* filepath, const char* argv0);
+void cbrew_config_dep_filepath(char* dep_filepath, const CbrewConfig* config, const char* filepath);
 
 /**
-* Executes a command on the command prompt.
-* @param format The command or command format.
-* @return Returns CBREW_TRUE if the command was executed and returned EXIT_SUCCESS, CBREW_FALSE oherwise.
+* Retrieves the path of the executable that a test or benchmark project creates for a given source file, which is named after the source file.
+* @param test_filepath A string large enough to store the executable filepath.
+* @param config The config whose target directory contains the executable.
+* @param filepath The filepath of the test or benchmark source file.
 */
-CbrewBool cbrew_command(const char* format, ...);
+void cbrew_config_test_filepath(char* test_filepath, const CbrewConfig* config, const char* filepath);
 
 /**
-* Checks if the last modification time of the first file was before the last modification time of the second file.
-* @param first_file The first file.
-* @param second_file The second file.
-* @return Returns CBREW_TRUE if first_file is older than second_file, CBREW_FALSE otherwise.
+* Retrieves the path of the file that records that a test has passed, so it isn't run again until it or its inputs change.
+* @param stamp_filepath A string large enough to store the stamp filepath.
+* @param config The config whose object directory contains the stamp file.
+* @param filepath The filepath of the test source file.
 */
-CbrewBool cbrew_first_file_is_older(const char* first_file, const char* second_file);
+void cbrew_config_test_stamp_filepath(char* stamp_filepath, const CbrewConfig* config, const char* filepath);
 
 /**
-* Checks if a file exists.
-* @param file The path of the file.
-* @return Returns CBREW_TRUE when the file exists, CBREW_FALSE otherwise.
+* Retrieves the path of the file that a benchmark writes its results into.
+* @param results_filepath A string large enough to store the results filepath.
+* @param config The config whose object directory contains the results file.
+* @param filepath The filepath of the benchmark source file.
 */
-CbrewBool cbrew_file_exists(const char* file);
+void cbrew_config_benchmark_results_filepath(char* results_filepath, const CbrewConfig* config, const char* filepath);
 
 /**
-* Renames a file. If a file with the new name already exists, it will be overwritten.
-* @param old_name The path of the file which name shall be changed.
-* @param new_name The path that the file shall be renamed to.
-* @return Returns CBREW_TRUE when the file could be renamed, CBREW_FALSE otherwise.
+* Retrieves the path of the split debug information file, which the compiler creates for a given source file if the config links fast.
+* @param dwo_filepath A string large enough to store the split debug information filepath.
+* @param config The config whose object directory contains the split debug information file.
+* @param filepath The filepath of the source file.
 */
-CbrewBool cbrew_file_rename(const char* old_name, const char* new_name);
+void cbrew_config_dwo_filepath(char* dwo_filepath, const CbrewConfig* config, const char* filepath);
 
 /**
-* Copies a file.
-* @param src_path The filepath to the file that is to be copied.
-* @param dest_path The filepath to which the file will be copied.
-* @return Returns CBREW_TRUE if the file was copied successfully, CBREW_FALSE otherwise.
+* Creates a string which contains all object files inside the config's object directory.
+* Products that are created by an action graph only use the object files of the graph's compile actions instead.
+* @param config The config of which the object files inside the object directory should be retrieved.
+* @return Returns a string which contains all object files inside the config's object directory. This string must be freed by the caller.
 */
-CbrewBool cbrew_file_copy(const char* src_path, const char* dest_path);
+char* cbrew_config_create_obj_files_str(const CbrewConfig* config);
 
 /**
-* Deletes a file.
-* @param file The path of the file to delete.
-* @return Returns CBREW_TRUE if the file could be deleted, CBREW_FALSE otherwise.
+* Retrieves the path of the manifest, which lists every file that has been created for a config.
+* @param manifest_filepath A string large enough to store the manifest filepath.
+* @param config The config whose object directory contains the manifest.
 */
-CbrewBool cbrew_file_delete(const char* file);
+void cbrew_config_manifest_filepath(char* manifest_filepath, const CbrewConfig* config);
+
+/* Toolchains */
 
 /**
-* Retrieves the directory for a given wildcard.
-* @param dir The string to hold the retrieved directory.
-* @param wildcard The wildcard to retrieve the directory from.
+* Creates a new toolchain, which uses "ar" as its archiver and the default linker of the compiler.
+* @param name The name of the toolchain, which can be selected with the "--toolchain=<name>" argument.
+* @param compiler The compiler command, e.g. "clang" or "gcc-13".
+* @return Returns a pointer to the created toolchain.
 */
-void cbrew_wildcard_directory(char* dir, const char* wildcard);
+CbrewToolchain* cbrew_toolchain_create(const char* name, const char* compiler);
 
 /**
- * Checks whether or not a filepath matches a given wildcard.
- * @param filepath The filepath to match against.
- * @param wildcard The wildcard that will be matched against.
- * @return Returns CBREW_TRUE if the filepath matches the wildcard, CBREW_FALSE otherwise.
- */
-CbrewBool cbrew_file_matches_wildcard(const char* filepath, const char* wildcard);
+* Retrieves the default toolchain, which is named "default".
+* Its compiler, archiver and launcher are read from the environment variables CBREW_CC, CBREW_AR and CBREW_LAUNCHER.
+* Without these variables, the compiler that compiled cbrew and "ar" are used.
+* @return Returns a pointer to the default toolchain.
+*/
+CbrewToolchain* cbrew_toolchain_default(void);
 
 /**
-* Scans a directory for all files and returns an array of strings containing the filenames.
-* @param dir The directory to scan for files.
-* @param files_count A pointer whose value will be set to the amount of files found. If NULL, no count will be set.
-* @return Returns a string array of the found files or NULL if no files were found. The individual strings as well as the array itself needs to be freed by the caller.
+* Searches for a toolchain by its name.
+* @param name The name of the toolchain.
+* @return Returns a pointer to the toolchain, or NULL if no toolchain with this name exists.
 */
-char** cbrew_find_files(const char* dir, size_t* files_count);
+CbrewToolchain* cbrew_toolchain_find(const char* name);
 
 /**
-* Scans a directory and all subdirectories for all files and returns an array of strings containing the filenames.
-* @param dir The directory to scan for files.
-* @param files_count A pointer whose value will be set to the amount of files found. If NULL, no count will be set.
-* @return Returns a string array of the found files or NULL if no files were found. The individual strings as well as the array itself needs to be freed by the caller.
+* Sets the archiver that creates static libraries, e.g. "llvm-ar" or "gcc-ar" for libraries containing LTO objects.
+* @param toolchain The toolchain whose archiver will be set.
+* @param archiver The archiver command.
 */
-char** cbrew_find_files_recursive(const char* dir, size_t* files_count);
+void cbrew_toolchain_set_archiver(CbrewToolchain* toolchain, const char* archiver);
 
 /**
-* Checks if a directory exists.
-* @param dir The path of the directory.
-* @return Returns CBREW_TRUE if the directory exists, CBREW_FALSE otherwise.
+* Sets the linker that is passed to the compiler with "-fuse-ld=", e.g. "lld" or "mold".
+* If the compiler can't use the linker, the default linker is used instead.
+* @param toolchain The toolchain whose linker will be set.
+* @param linker The name of the linker, or NULL to use the default linker of the compiler.
 */
-CbrewBool cbrew_dir_exists(const char* dir);
+void cbrew_toolchain_set_linker(CbrewToolchain* toolchain, const char* linker);
 
 /**
-* Creates a new directory.
-* @param dir The path of the directory which will be created.
-* @return Returns CBREW_TRUE if the directory could be created, CBREW_FALSE otherwise.
+* Sets a command that is put in front of every compile command, e.g. "ccache".
+* The launcher isn't part of the command signature, so changing it doesn't rebuild anything.
+* @param toolchain The toolchain whose launcher will be set.
+* @param launcher The launcher command, or NULL to run the compiler directly.
 */
-CbrewBool cbrew_dir_create(const char* dir);
+void cbrew_toolchain_set_launcher(CbrewToolchain* toolchain, const char* launcher);
 
-#ifdef CBREW_IMPLEMENTATION
+/**
+* Detects which features the compiler of the toolchain supports by compiling a small test program.
+* The results are cached inside .cbrew/toolchains and only detected again when the compiler changes.
+* Toolchains are probed only once, so calling this function multiple times has no further effect.
+* Dry runs and cleaning never run the compiler, so without cached results only dependency files are assumed to be supported.
+* @param toolchain The toolchain to probe.
+*/
+void cbrew_toolchain_probe(CbrewToolchain* toolchain);
 
-typedef struct CbrewHandler
-{
-    CbrewProject* projects;
-    size_t projects_count;
-} CbrewHandler;
+/**
+* Checks whether the compiler of the toolchain supports a feature, and probes the toolchain if necessary.
+* @param toolchain The toolchain to check.
+* @param capabilities One or more CBREW_TOOLCHAIN_CAPABILITY_* flags.
+* @return Returns CBREW_TRUE if all of the capabilities are supported, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_toolchain_supports(CbrewToolchain* toolchain, CbrewToolchainCapabilities capabilities);
 
-static CbrewHandler handler;
+/* Actions */
 
-void cbrew_build(void)
-{
-    const clock_t start = clock();
+/**
+* Adds a new action to an action graph.
+* @param graph The graph to which the action will be added.
+* @param type The type of the action.
+* @param project The project that the action belongs to.
+* @param config The config that the action belongs to.
+* @param input The source file of a compile action, NULL for other action types.
+* @return Returns the index of the newly added action.
+*/
+size_t cbrew_graph_add_action(CbrewGraph* graph, CbrewActionType type, const CbrewProject* project, const CbrewConfig* config, const char* input);
 
-    CbrewBool success = CBREW_TRUE;
+/**
+* Adds a dependency to an action, so that the action is only run after the dependency succeeded.
+* @param graph The graph containing both actions.
+* @param action The index of the action that depends on the other action.
+* @param dependency The index of the action that must succeed first.
+*/
+void cbrew_graph_add_dependency(CbrewGraph* graph, size_t action, size_t dependency);
 
-    for(size_t i = 0; i < handler.projects_count; ++i)
-    {
-        CbrewProject* project = &handler.projects[i];
-        if(!cbrew_project_build(project))
-            success = CBREW_FALSE;
-    }
+/**
+* Makes every product (executable or library) depend on the products of the library configs that its project links, as found by cbrew_link_find_config().
+* Products that don't link each other are created side by side, no matter to which projects and configs they belong.
+* @param graph The graph containing the actions of all projects.
+*/
+void cbrew_graph_add_link_dependencies(CbrewGraph* graph);
 
-    const clock_t end = clock();
+/**
+* Adds a new action to an action graph, which installs a file by hard linking or copying it.
+* @param graph The graph to which the action will be added.
+* @param project The project that the action belongs to.
+* @param config The config that the action belongs to.
+* @param input The file to install.
+* @param destination The filepath to which the file will be installed.
+* @return Returns the index of the newly added action.
+*/
+size_t cbrew_graph_add_install_action(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, const char* input, const char* destination);
 
-    const double building_time = (((double) end - start) / CLOCKS_PER_SEC) * 1000;
+/**
+* Retrieves the arguments that are shared by every action of a config, so they only need to be created once per graph.
+* @param graph The graph that owns the arguments.
+* @param project The project of the config.
+* @param config The config whose arguments will be retrieved.
+* @return Returns the arguments of the config, which stay valid until the graph is freed. They also list the object files of all compile actions of the config.
+*/
+CbrewConfigArgs* cbrew_graph_config_args(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config);
 
-    if(success)
-        CBREW_LOG_INFO("Successfully built all projects %s(%.0lfms)", CBREW_CONSOLE_COLOR_TIME, building_time);
-    else
-        CBREW_LOG_ERROR("Build process finished with errors! %s(%.0lfms)", CBREW_CONSOLE_COLOR_TIME, building_time);
-}
+/**
+* Calculates the signature of a compile action, which only depends on the command compiling the source file, but not on the config's paths.
+* @param action The compile action whose signature will be calculated.
+* @return Returns the signature of the compile action.
+*/
+uint64_t cbrew_action_compile_signature(const CbrewAction* action);
 
-/* Projects */
+/**
+* Turns compile actions that would compile the same source file with the same command as a previous compile action into share actions.
+* A share action hard links (or copies) the object and dependency files of the previous compile action into its own object directory, after that compile action succeeded.
+* Compile actions that split the debug information aren't shared, since the object file refers to the split debug information file of its own config.
+* @param graph The graph containing the actions.
+* @param begin The index of the first action to compare, usually the first action of a project.
+* @param end The index after the last action to compare.
+*/
+void cbrew_graph_share_compile_actions(CbrewGraph* graph, size_t begin, size_t end);
 
-CbrewProject* cbrew_project_create(const char* name, CbrewProjectType type)
-{
-    CBREW_ASSERT(name != NULL);
-    CBREW_ASSERT(type < CBREW_PROJECT_TYPE_SIZE);
+/**
+* Compares two pointers to actions by their signature and their position inside the graph, so actions can be sorted with qsort.
+* @param a A pointer to a pointer to the first action.
+* @param b A pointer to a pointer to the second action.
+* @return Returns a negative value, zero or a positive value, if the first action is less than, equal to or greater than the second action.
+*/
+int cbrew_action_compare_signatures(const void* a, const void* b);
 
-    for(size_t i = 0; i < handler.projects_count; ++i)
-    {
-        if(strcmp(handler.projects[i].name, name) == 0)
-        {
-            CBREW_LOG_WARN("Project with name %s%s%s already exists!", CBREW_CONSOLE_COLOR_PROJECT, name, CBREW_CONSOLE_COLOR_WARN);
-            return &handler.projects[i];
-        }
-    }
+/**
+* Sorts the actions of the graph, so that every action comes after all of its dependencies.
+* @param graph The graph whose actions will be sorted.
+* @return Returns the indices of all actions in topological order. This array must be freed by the caller.
+*/
+size_t* cbrew_graph_topological_order(const CbrewGraph* graph);
 
-    ++handler.projects_count;
-    handler.projects = realloc(handler.projects, handler.projects_count * sizeof(CbrewProject));
+/**
+* Adds an action to the queue of ready actions, which is ordered by the critical path of the actions.
+* @param graph The graph containing the action.
+* @param ready_actions The queue of ready actions, large enough to store every action of the graph.
+* @param ready_count A pointer to the number of actions inside the queue.
+* @param action The index of the action to add.
+*/
+void cbrew_graph_ready_push(const CbrewGraph* graph, size_t* ready_actions, size_t* ready_count, size_t action);
 
-    CbrewProject* project = &handler.projects[handler.projects_count - 1];
+/**
+* Removes the action with the longest critical path from the queue of ready actions.
+* @param graph The graph containing the actions.
+* @param ready_actions The queue of ready actions.
+* @param ready_count A pointer to the number of actions inside the queue, which must be greater than 0.
+* @return Returns the index of the removed action.
+*/
+size_t cbrew_graph_ready_pop(const CbrewGraph* graph, size_t* ready_actions, size_t* ready_count);
 
-    memset(project, 0, sizeof(CbrewProject));
+/**
+* Runs all actions of the graph, where up to cbrew_get_jobs() actions run at the same time.
+* Ready actions are started in order of their critical path, i.e. the estimated time from starting the action until every action depending on it has finished, based on the durations of previous builds.
+* If a GNU make jobserver is active, every action except the first running one additionally holds one of its tokens.
+* Actions whose output is already up to date are not run again.
+* If an action fails, all actions depending on it are skipped, and unless cbrew_get_keep_going() is enabled, the remaining actions of the same config as well.
+* @param graph The graph whose actions will be run.
+* @return Returns CBREW_TRUE if every action succeeded, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_graph_run(CbrewGraph* graph);
 
-    project->name = name;
-    project->type = type;
+/**
+* Logs every failed action of the last run, so all failures can be found at the end of the build.
+* @param graph The graph whose actions have been run.
+*/
+void cbrew_graph_log_failures(const CbrewGraph* graph);
 
-    return project;
-}
+/**
+* Logs the longest chain of dependent actions of the last run and compares its duration with the wall time of the run.
+* @param graph The graph whose actions have been run.
+* @param wall_time The wall time of the run in milliseconds.
+*/
+void cbrew_graph_log_critical_path(const CbrewGraph* graph, double wall_time);
 
-void cbrew_project_add_files(CbrewProject* project, const char* wildcard)
-{
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(wildcard != NULL);
+/**
+* Appends a record of the last run to the build statistics, which keep the records of the most recent builds.
+* A record stores the wall time, the amount of run, up to date, failed and skipped actions, the highest peak memory usage of a single action, the time of every built config
+* and the targets that selected the built configs, so builds of different targets are never compared with each other.
+* @param graph The graph whose actions have been run.
+* @param wall_time The wall time of creating and running the actions in milliseconds.
+* @param success CBREW_TRUE if the build succeeded, CBREW_FALSE otherwise.
+*/
+void cbrew_graph_record_stats(const CbrewGraph* graph, double wall_time, CbrewBool success);
 
-    ++project->wildcards_count;
-    project->wildcards = realloc(project->wildcards, project->wildcards_count * sizeof(char*));
-    project->wildcards[project->wildcards_count - 1] = cbrew_path(strdup(wildcard));
-}
+/**
+* Frees all actions of the graph.
+* @param graph The graph to free.
+*/
+void cbrew_graph_free(CbrewGraph* graph);
 
-void cbrew_project_add_flag(CbrewProject* project, const char* flag)
-{
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(flag != NULL);
+/**
+* Runs a single action without any dependencies.
+* @param type The type of the action.
+* @param project The project that the action belongs to.
+* @param config The config that the action belongs to.
+* @param input The source file of a compile action, NULL for other action types.
+* @return Returns CBREW_TRUE if the action succeeded, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_action_run(CbrewActionType type, const CbrewProject* project, const CbrewConfig* config, const char* input);
 
-    ++project->flags_count;
-    project->flags = realloc(project->flags, project->flags_count * sizeof(char*));
-    project->flags[project->flags_count - 1] = strdup(flag);
-}
+/**
+* Retrieves the path of the file that the action creates.
+* @param filepath A string large enough to store the filepath.
+* @param action The action whose output will be retrieved.
+*/
+void cbrew_action_output_filepath(char* filepath, const CbrewAction* action);
 
-void cbrew_project_add_define(CbrewProject* project, const char* define)
-{
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(define != NULL);
+/**
+* Checks whether the output of an action is still up to date, so the action doesn't need to be run.
+* Products are only up to date if none of their dependencies has been run during the current build.
+* @param graph The graph that the action belongs to.
+* @param action The action to check.
+* @param reason A string large enough to store a filepath and a short message, which receives why the action needs to be run. May be NULL.
+* @return Returns CBREW_TRUE if the action has been run with the same command before and its output is newer than all of its inputs, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_action_is_up_to_date(const CbrewGraph* graph, const CbrewAction* action, char* reason);
 
-    ++project->defines_count;
-    project->defines = realloc(project->defines, project->defines_count * sizeof(char*));
-    project->defines[project->defines_count - 1] = strdup(define);
-}
+/**
+* Creates the command that executes the action.
+* @param action The action whose command will be created.
+* @return Returns the command of the action. This string must be freed by the caller.
+*/
+char* cbrew_action_create_command(const CbrewAction* action);
 
-void cbrew_project_add_include_dir(CbrewProject* project, const char* include_dir)
-{
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(include_dir != NULL);
+/**
+* Creates a command that only replaces the changed members of an existing static library.
+* This is only possible if the static library has been created from the same objects with the same command before.
+* @param graph The graph that the action belongs to.
+* @param action The static library action whose command will be created.
+* @return Returns the command that updates the static library, or NULL if the static library needs to be created from scratch. This string must be freed by the caller.
+*/
+char* cbrew_action_create_archive_update_command(const CbrewGraph* graph, const CbrewAction* action);
 
-    ++project->include_dirs_count;
-    project->include_dirs = realloc(project->include_dirs, project->include_dirs_count * sizeof(char*));
-    project->include_dirs[project->include_dirs_count - 1] = cbrew_path(strdup(include_dir));
-}
+/* Benchmarks */
 
-void cbrew_project_add_link(CbrewProject* project, const char* link)
-{
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(link != NULL);
+/**
+* Runs a benchmark once to warm up and then once per sample, summarizes every metric it reports and compares the metrics to their baselines.
+* Benchmarks report a metric by writing a line "BENCH <metric> <value> [unit]" to the standard output, where lower values are better.
+* The summaries of benchmarks without a failing regression are appended to the benchmark history, whose recent medians form the baselines.
+* @param action The benchmark action to run. Its output is set to the reason if the benchmark fails.
+* @param cmd The command that runs the benchmark once and writes its standard output into its results file.
+* @return Returns CBREW_TRUE if every sample of the benchmark succeeded and no metric regressed beyond the fail threshold, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_action_run_benchmark(CbrewAction* action, const char* cmd);
 
-    ++project->links_count;
-    project->links = realloc(project->links, project->links_count * sizeof(char*));
-    project->links[project->links_count - 1] = cbrew_path(strdup(link));
-}
+/**
+* Adds every metric that the results of a single benchmark run report to the samples of the metrics.
+* @param results The standard output of the benchmark run.
+* @param metrics The array of metrics, which is grown as needed. The array and the samples of every metric must be freed by the caller.
+* @param metrics_count The amount of metrics inside the array.
+* @param metrics_capacity The capacity of the array.
+*/
+void cbrew_benchmark_parse_results(const char* results, CbrewBenchmarkMetric** metrics, size_t* metrics_count, size_t* metrics_capacity);
 
-CbrewBool cbrew_project_file_matches_wildcards(const CbrewProject* project, const char* filepath)
-{
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(filepath != NULL);
+/**
+* Summarizes the samples of a metric.
+* @param samples The samples to summarize, which are sorted afterwards.
+* @param samples_count The amount of samples, which must be at least 1.
+* @param median Receives the median of the samples.
+* @param p95 Receives the 95th percentile of the samples.
+* @param stddev Receives the standard deviation of the samples.
+*/
+void cbrew_samples_summarize(double* samples, size_t samples_count, double* median, double* p95, double* stddev);
 
-    for(size_t i = 0; i < project->wildcards_count; ++i)
-    {
-        if(cbrew_file_matches_wildcard(filepath, project->wildcards[i]))
-            return CBREW_TRUE;
-    }
+/**
+* Retrieves the baseline of a benchmark metric, which is the median of its most recent recorded medians.
+* @param history The content of the benchmark history, or NULL if there is no history.
+* @param benchmark The filepath of the benchmark executable.
+* @param metric The name of the metric.
+* @param baseline Receives the baseline of the metric.
+* @return Returns CBREW_TRUE if the metric has been recorded before, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_benchmark_baseline(const char* history, const char* benchmark, const char* metric, double* baseline);
 
-    return CBREW_FALSE;
-}
+/**
+* Compares two doubles, so arrays of doubles can be sorted with qsort.
+* @param a A pointer to the first double.
+* @param b A pointer to the second double.
+* @return Returns a negative value, zero or a positive value, if the first double is less than, equal to or greater than the second double.
+*/
+int cbrew_double_compare(const void* a, const void* b);
 
-char** cbrew_project_find_source_files(const CbrewProject* project, size_t* files_count)
-{
-    CBREW_ASSERT(project != NULL);
+/**
+* Calculates the square root of a value without depending on the math library, which isn't linked into every cbrew executable.
+* @param value The value, which must not be negative.
+* @return Returns the square root of the value.
+*/
+double cbrew_sqrt(double value);
 
-    size_t files_found_count = 0;
-    char** files_found = cbrew_find_files_recursive(".", &files_found_count);
+/* Statistics */
+
+/**
+* Parses a single record of the build statistics.
+* @param line The line containing the record, which is split in place.
+* @param record Receives the record. Its configs and selection point into the line. Records written before targets were recorded have the selection "*", like builds of all projects.
+* @return Returns CBREW_TRUE if the line contains a valid record, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_stats_parse_record(char* line, CbrewStatsRecord* record);
+
+/**
+* Logs the most recent builds recorded in the build statistics together with the time of every built config, and flags builds that were significantly slower than the builds before them.
+* Builds are only compared with builds of the same targets. Builds that ran no action are compared by their wall time with other such builds, while all other builds are compared by their wall time per run action,
+* so a full rebuild isn't flagged just because it follows many incremental builds.
+* @param records_count The amount of recent builds to log.
+* @return Returns CBREW_TRUE if any build has been recorded, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_stats_report(size_t records_count);
+
+/* History */
+
+/**
+* Loads the history of previous builds, which stores measurements (peak memory usage and duration) per action output.
+* @param history The history to load into.
+* @param filepath The path of the history file. A missing file results in an empty history.
+*/
+void cbrew_history_load(CbrewHistory* history, const char* filepath);
+
+/**
+* Saves the history of previous builds.
+* @param history The history to save.
+* @param filepath The path of the history file.
+* @return Returns CBREW_TRUE if the history was saved, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_history_save(const CbrewHistory* history, const char* filepath);
+
+/**
+* Retrieves the history entry for a given key.
+* @param history The history to search.
+* @param key The key of the entry, usually the output path of an action.
+* @param create If CBREW_TRUE, a new entry is created if there is no entry for the key.
+* @return Returns the entry for the key, or NULL if there is no entry and create is CBREW_FALSE.
+*/
+CbrewHistoryEntry* cbrew_history_get(CbrewHistory* history, const char* key, CbrewBool create);
+
+/**
+* Frees all entries of the history.
+* @param history The history to free.
+*/
+void cbrew_history_free(CbrewHistory* history);
+
+/* Include cache */
+
+/**
+* Loads the include cache, which stores the #include directives of every scanned file together with the modification time of the file.
+* @param cache The cache to load into.
+* @param filepath The path of the cache file. A missing file results in an empty cache.
+*/
+void cbrew_include_cache_load(CbrewIncludeCache* cache, const char* filepath);
+
+/**
+* Saves the include cache.
+* @param cache The cache to save.
+* @param filepath The path of the cache file.
+* @return Returns CBREW_TRUE if the cache was saved, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_include_cache_save(const CbrewIncludeCache* cache, const char* filepath);
+
+/**
+* Retrieves the include cache entry for a given file.
+* @param cache The cache to search.
+* @param key The filepath of the file.
+* @param create If CBREW_TRUE, a new entry is created if there is no entry for the file.
+* @return Returns the entry for the file, or NULL if there is no entry and create is CBREW_FALSE.
+*/
+CbrewIncludeCacheEntry* cbrew_include_cache_get(CbrewIncludeCache* cache, const char* key, CbrewBool create);
+
+/**
+* Retrieves the #include directives of a file, which are only scanned again if the file has been modified since it was scanned last.
+* @param cache The cache that stores the directives.
+* @param filepath The filepath of the file.
+* @return Returns the directives like cbrew_file_scan_includes(), or NULL if the file doesn't exist. The string is owned by the cache.
+*/
+const char* cbrew_include_cache_scan(CbrewIncludeCache* cache, const char* filepath);
+
+/**
+* Frees all entries of the include cache.
+* @param cache The cache to free.
+*/
+void cbrew_include_cache_free(CbrewIncludeCache* cache);
+
+/* Jobserver */
+
+/**
+* Connects to the jobserver of a parent GNU make, which is announced through the --jobserver-auth option inside the MAKEFLAGS environment variable.
+* If there is no parent jobserver, cbrew becomes the jobserver for its child processes (e.g. a nested make or gcc with -flto=jobserver) by exporting MAKEFLAGS.
+* @param jobserver The jobserver to initialize.
+* @param jobs The total amount of jobs that are shared with child processes when cbrew becomes the jobserver.
+* @return Returns CBREW_TRUE if the jobserver is active or not needed, CBREW_FALSE if the parent jobserver can't be used.
+*/
+CbrewBool cbrew_jobserver_init(CbrewJobserver* jobserver, size_t jobs);
+
+/**
+* Tries to acquire a token from the jobserver, which allows running one more job.
+* @param jobserver The jobserver to acquire the token from.
+* @param timeout_ms The maximum time in milliseconds to wait for a token, or 0 to return immediately.
+* @return Returns CBREW_TRUE if a token was acquired, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_jobserver_acquire(CbrewJobserver* jobserver, int timeout_ms);
+
+/**
+* Returns one of the acquired tokens to the jobserver.
+* @param jobserver The jobserver to return the token to.
+*/
+void cbrew_jobserver_release(CbrewJobserver* jobserver);
+
+/**
+* Reads a single token from the jobserver.
+* @param jobserver The jobserver to read from.
+* @param timeout_ms The maximum time in milliseconds to wait for a token, or 0 to return immediately.
+* @param token A pointer whose value will be set to the token that was read.
+* @return Returns CBREW_TRUE if a token was read, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_jobserver_read_token(CbrewJobserver* jobserver, int timeout_ms, char* token);
+
+/**
+* Writes a single token back to the jobserver.
+* @param jobserver The jobserver to write to.
+* @param token The token to write.
+*/
+void cbrew_jobserver_write_token(CbrewJobserver* jobserver, char token);
+
+/* Memory */
+
+/**
+* Allocates memory from an arena. The memory stays valid until the arena is freed.
+* @param arena The arena to allocate from.
+* @param size The amount of bytes to allocate.
+* @return Returns a pointer to the zero-initialized memory, which is suitably aligned for any type.
+*/
+void* cbrew_arena_alloc(CbrewArena* arena, size_t size);
+
+/**
+* Copies a string into an arena.
+* @param arena The arena to allocate from.
+* @param str The string to copy.
+* @return Returns the copied string, which stays valid until the arena is freed.
+*/
+char* cbrew_arena_strdup(CbrewArena* arena, const char* str);
+
+/**
+* Makes sure that an array allocated from an arena has room for one more element.
+* If the array is full, its capacity is doubled by moving it to a new location.
+* @param arena The arena to allocate from.
+* @param array The array to grow, or NULL if the array has not been allocated yet.
+* @param count The element count of the array.
+* @param capacity A pointer to the capacity of the array, which will be updated when the array grows.
+* @param element_size The size of a single element.
+* @return Returns the array, which might have been moved.
+*/
+void* cbrew_arena_array_grow(CbrewArena* arena, void* array, size_t count, size_t* capacity, size_t element_size);
+
+/**
+* Frees all memory of an arena at once.
+* @param arena The arena to free.
+*/
+void cbrew_arena_free(CbrewArena* arena);
+
+/**
+* Interns a string, so that equal strings share the same storage and can be compared by their address.
+* Interned strings stay valid until cbrew_free() is called.
+* @param str The string to intern.
+* @return Returns the interned string.
+*/
+const char* cbrew_intern(const char* str);
+
+/**
+* Interns a path after converting it with cbrew_path().
+* @param path The path to intern.
+* @return Returns the interned path.
+*/
+const char* cbrew_intern_path(const char* path);
+
+/* String builder */
+
+/**
+* Makes sure that a string builder has room for additional characters and a null terminator.
+* @param sb The string builder to grow.
+* @param len The amount of characters that will be appended.
+*/
+void cbrew_string_builder_reserve(CbrewStringBuilder* sb, size_t len);
+
+/**
+* Appends a string to a string builder. The buffer of the string builder grows geometrically, so appending is amortized linear.
+* @param sb The string builder to append to.
+* @param str The string to append.
+*/
+void cbrew_string_builder_append(CbrewStringBuilder* sb, const char* str);
+
+/**
+* Appends a formatted string to a string builder.
+* @param sb The string builder to append to.
+* @param format The format of the string to append.
+*/
+void cbrew_string_builder_append_format(CbrewStringBuilder* sb, const char* format, ...);
+
+/**
+* Appends a single quoted argument to a string builder, so the command prompt passes it on unchanged, no matter which quotes or special characters it contains.
+* @param sb The string builder to append to.
+* @param arg The argument to append.
+*/
+void cbrew_string_builder_append_argument(CbrewStringBuilder* sb, const char* arg);
+
+/**
+* Appends all elements of the specified array to a string builder.
+* Every element is followed by a whitespace.
+* @param sb The string builder to append to.
+* @param flags The string array containing the flags.
+* @param flags_count The element count of flags.
+*/
+void cbrew_string_builder_append_flags(CbrewStringBuilder* sb, const char** flags, size_t flags_count);
+
+/**
+* Appends all elements of the specified array to a string builder.
+* "-D" will be inserted before every define and every define is followed by a whitespace.
+* @param sb The string builder to append to.
+* @param defines The string array containing the defines.
+* @param defines_count The element count of defines.
+*/
+void cbrew_string_builder_append_defines(CbrewStringBuilder* sb, const char** defines, size_t defines_count);
+
+/**
+* Appends all elements of the specified array to a string builder.
+* "-I" will be inserted before every include directory and every include directory is followed by a whitespace.
+* @param sb The string builder to append to.
+* @param include_dirs The string array containing the include directories.
+* @param include_dirs_count The element count of include_dirs.
+*/
+void cbrew_string_builder_append_include_dirs(CbrewStringBuilder* sb, const char** include_dirs, size_t include_dirs_count);
+
+/**
+* Appends all elements of the specified array to a string builder.
+* Every link is split into "-L" for its directory and "-l" for its name, each followed by a whitespace.
+* @param sb The string builder to append to.
+* @param links The string array containing the links.
+* @param links_count The element count of links.
+*/
+void cbrew_string_builder_append_links(CbrewStringBuilder* sb, const char** links, size_t links_count);
+
+/**
+* Takes the string out of a string builder, leaving the string builder empty.
+* @param sb The string builder whose string will be taken.
+* @return Returns the built string, which is never NULL. This string must be freed by the caller.
+*/
+char* cbrew_string_builder_release(CbrewStringBuilder* sb);
+
+/**
+* Frees the buffer of a string builder.
+* @param sb The string builder to free.
+*/
+void cbrew_string_builder_free(CbrewStringBuilder* sb);
+
+/* Util */
+
+/**
+* Creates a new string from a format.
+* @param format The format of the string.
+* @return Returns the formatted string. This string must be freed by the caller.
+*/
+char* cbrew_create_str(const char* format, ...);
+
+/**
+* Searches for a program inside the directories of the PATH environment variable.
+* @param filepath A string large enough to store the filepath of the program.
+* @param program The name of the program, which may also be a path already.
+* @return Returns CBREW_TRUE if the program has been found, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_program_filepath(char* filepath, const char* program);
+
+/**
+* Finds the compiler executable inside a compiler command, which may start with a launcher like ccache and may be followed by arguments.
+* @param program A string large enough to store the compiler, which can be passed to cbrew_program_filepath().
+* @param compiler The compiler command, e.g. "ccache gcc -m32", which results in "gcc".
+*/
+void cbrew_compiler_program(char* program, const char* compiler);
+
+/**
+* Calculates the 64-bit FNV-1a hash of a string.
+* @param str The string to hash.
+* @return Returns the hash of the string.
+*/
+uint64_t cbrew_hash_str(const char* str);
+
+/**
+* Compares two strings of a string array, so string arrays can be sorted and searched with qsort and bsearch.
+* @param a A pointer to the first string.
+* @param b A pointer to the second string.
+* @return Returns a negative value, zero or a positive value, if the first string is less than, equal to or greater than the second string.
+*/
+int cbrew_str_compare(const void* a, const void* b);
+
+/**
+* Converts any string to a valid path string for the current system by replacing every '/' character with the CBREW_PATH_SEPARATOR character.
+* @param path The path to convert.
+* @return Returns the modified string.
+*/
+char* cbrew_path(char* path);
+
+/**
+* Creates a string which contains all elements of the specicfied array.
+* The individual strings are separated by a whitespace.
+* @param flags The string array containing the flags.
+* @param flags_count The element count of flags.
+* @return Returns a string which contains all elements of flags. This string must be freed by the caller.
+*/
+char* cbrew_create_flags_str(const char** flags, size_t flags_count);
+
+/**
+* Creates a string which contains all elements of the specicfied array.
+* "-D" will be inserted before every define.
+* The individual strings are separated by a whitespace.
+* @param defines The string array containing the defines.
+* @param defines_count The element count of defines.
+* @return Returns a string which contains all elements of defines. This string must be freed by the caller.
+*/
+char* cbrew_create_defines_str(const char** defines, size_t defines_count);
+
+/**
+* Creates a string which contains all elements of the specicfied array.
+* "-L" will be inserted before every include directory.
+* The individual strings are separated by a whitespace.
+* @param include_dirs The string array containing the include_dirs.
+* @param include_dirs_count The element count of include_dirs.
+* @return Returns a string which contains all elements of include_dirs. This string must be freed by the caller.
+*/
+char* cbrew_create_include_dirs_str(const char** include_dirs, size_t include_dirs_count);
+
+/**
+* Creates a string which contains all elements of the specicfied array.
+* "-l" will be inserted before every link.
+* The individual strings are separated by a whitespace.
+* @param links The string array containing the links.
+* @param links_count The element count of links.
+* @return Returns a string which contains all elements of links. This string must be freed by the caller.
+*/
+char* cbrew_create_links_str(const char** links, size_t links_count);
+
+/* IO */
+
+/**
+* Copies the filepath inside argv[0] into filepath with the correct extension, if the extension of the executable is not already inside argv[0].
+* @param filepath A string large enough to store the filepath.
+*/
+void cbrew_executable_filepath(char* filepath, const char* argv0);
+
+/**
+* Executes a command on the command prompt.
+* @param format The command or command format.
+* @return Returns CBREW_TRUE if the command was executed and returned EXIT_SUCCESS, CBREW_FALSE oherwise.
+*/
+CbrewBool cbrew_command(const char* format, ...);
+
+/**
+* Retrieves a monotonic timestamp, which is suitable for measuring elapsed wall time.
+* @return Returns the current timestamp in milliseconds.
+*/
+double cbrew_time_ms(void);
+
+/**
+* Retrieves the amount of processors that are available to run commands.
+* @return Returns the amount of available processors, but at least 1.
+*/
+size_t cbrew_processor_count(void);
+
+/**
+* Starts a command on the command prompt without waiting for it to finish.
+* @param process A pointer whose value will be set to the started process.
+* @param cmd The command to start.
+* @param capture_output If CBREW_TRUE, everything the command writes to stdout and stderr is collected in the output of the process instead of being written to the console. Output is currently only captured on Linux.
+* @param own_group If CBREW_TRUE, the process and every process it starts are grouped (a process group on Linux, a job object on Windows), so cbrew_process_kill() stops all of them. Grouped processes don't receive Ctrl+C from the console.
+* @return Returns CBREW_TRUE if the process was started, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_process_start(CbrewProcess* process, const char* cmd, CbrewBool capture_output, CbrewBool own_group);
+
+/**
+* Appends all output that is currently available from a process to its output, without waiting for more output.
+* @param process The process whose output will be read.
+*/
+void cbrew_process_read_output(CbrewProcess* process);
+
+/**
+* Waits until any of the specified processes has finished, while collecting the output of all processes.
+* The output of the finished process is complete once this function returns, and must be freed by the caller.
+* @param processes The processes to wait for.
+* @param processes_count The element count of processes.
+* @param timeout_ms The maximum time to wait in milliseconds. 0 only reports processes that have already finished, while a negative timeout waits until a process has finished.
+* @param index A pointer whose value will be set to the index of the finished process.
+* @param success A pointer whose value will be set to CBREW_TRUE if the process returned EXIT_SUCCESS, CBREW_FALSE otherwise.
+* @param peak_memory_kb A pointer whose value will be set to the peak memory usage of the process and its children in kilobytes, or 0 if it is unknown. If NULL, no peak memory usage will be set.
+* @return Returns CBREW_TRUE if a process has finished, CBREW_FALSE if no process has finished before the timeout or waiting failed.
+*/
+CbrewBool cbrew_process_wait_any(CbrewProcess* processes, size_t processes_count, int timeout_ms, size_t* index, CbrewBool* success, size_t* peak_memory_kb);
+
+/**
+* Stops a running process immediately, together with every process it has started if it was started in its own group. The process still has to be waited for with cbrew_process_wait_any(), which reports it as failed.
+* @param process The process to stop.
+* @return Returns CBREW_TRUE if the process has been stopped, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_process_kill(CbrewProcess* process);
+
+/**
+* Checks whether the standard output is an interactive console, which allows updating the current line.
+* @return Returns CBREW_TRUE if the standard output is a console, CBREW_FALSE if it is redirected.
+*/
+CbrewBool cbrew_console_is_interactive(void);
+
+/**
+* Retrieves the amount of memory that is available for starting new processes without swapping.
+* @return Returns the available memory in kilobytes, or 0 if it is unknown.
+*/
+size_t cbrew_available_memory_kb(void);
+
+/**
+* Retrieves the system load average of the last minute.
+* @return Returns the load average, or 0 if it is unknown.
+*/
+double cbrew_load_average(void);
+
+/**
+* Retrieves the command line arguments of the running process, without the name of the executable.
+* @param args_count A pointer whose value will be set to the amount of arguments.
+* @return Returns the arguments. The arguments and the array itself must be freed by the caller.
+*/
+char** cbrew_command_line_args(size_t* args_count);
+
+/**
+* Checks if the last modification time of the first file was before the last modification time of the second file.
+* @param first_file The first file.
+* @param second_file The second file.
+* @return Returns CBREW_TRUE if first_file is older than second_file, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_first_file_is_older(const char* first_file, const char* second_file);
+
+/**
+* Retrieves the last modification time of a file, which is only meant to be compared with other modification times.
+* @param file The path of the file.
+* @return Returns the modification time with the highest precision available, or 0 if the file doesn't exist.
+*/
+uint64_t cbrew_file_mtime(const char* file);
+
+/**
+* Checks if a file exists.
+* @param file The path of the file.
+* @return Returns CBREW_TRUE when the file exists, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_file_exists(const char* file);
+
+/**
+* Renames a file. If a file with the new name already exists, it will be overwritten.
+* @param old_name The path of the file which name shall be changed.
+* @param new_name The path that the file shall be renamed to.
+* @return Returns CBREW_TRUE when the file could be renamed, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_file_rename(const char* old_name, const char* new_name);
+
+/**
+* Copies a file, including its permissions and modification time.
+* On Linux, the file is cloned if the filesystem supports it (e.g. btrfs or XFS), otherwise its content is copied inside the kernel whenever possible.
+* @param src_path The filepath to the file that is to be copied.
+* @param dest_path The filepath to which the file will be copied.
+* @return Returns CBREW_TRUE if the file was copied successfully, CBREW_FALSE otherwise. An incomplete copy is deleted.
+*/
+CbrewBool cbrew_file_copy(const char* src_path, const char* dest_path);
+
+/**
+* Creates a hard link to a file.
+* @param src_path The filepath to the file that will be linked.
+* @param link_path The filepath of the new link, which must not exist yet.
+* @return Returns CBREW_TRUE if the link was created successfully, CBREW_FALSE otherwise, e.g. if both paths are on different filesystems.
+*/
+CbrewBool cbrew_file_link(const char* src_path, const char* link_path);
+
+/**
+* Installs a file by hard linking it or, if that isn't possible, by copying it. Missing directories of the destination are created.
+* The file is created next to the destination first and renamed afterwards, so the destination is either the old or the new file, even if installing fails.
+* @param src_path The filepath to the file that will be installed.
+* @param dest_path The filepath to which the file will be installed.
+* @return Returns CBREW_TRUE if the file was installed successfully, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_file_install(const char* src_path, const char* dest_path);
+
+/**
+* Reads the whole content of a file.
+* @param filepath The path of the file to read.
+* @param size A pointer whose value will be set to the size of the file in bytes. If NULL, no size will be set.
+* @return Returns the null-terminated content of the file, or NULL if the file couldn't be read. This string must be freed by the caller.
+*/
+char* cbrew_file_read(const char* filepath, size_t* size);
+
+/**
+* Checks whether a file is newer than all prerequisites of a make rule, like the rules inside a dependency file created by the compiler with -MD.
+* @param filepath The file whose modification time is compared, usually the target of the rule.
+* @param rule The make rule, which will be modified while parsing it. The target of the rule is not checked.
+* @param newer_prerequisite A string large enough to store a filepath, which receives the first prerequisite that is newer than the file. May be NULL.
+* @return Returns CBREW_TRUE if no prerequisite has been modified after the file, CBREW_FALSE otherwise or if the file doesn't exist.
+*/
+CbrewBool cbrew_file_is_newer_than_rule(const char* filepath, char* rule, char* newer_prerequisite);
+
+/**
+* Finds the #include directives of a C source file or header, skipping comments and string literals.
+* Includes whose header is given by a macro are ignored.
+* @param filepath The file to scan.
+* @return Returns one directive per line including its quotes or angle brackets, e.g. "\"foo.h\"\n<stdio.h>\n", or NULL if the file can't be read. This string must be freed by the caller.
+*/
+char* cbrew_file_scan_includes(const char* filepath);
+
+/**
+* Deletes a file.
+* @param file The path of the file to delete.
+* @return Returns CBREW_TRUE if the file could be deleted, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_file_delete(const char* file);
+
+/**
+* Retrieves the directory for a given wildcard.
+* @param dir The string to hold the retrieved directory.
+* @param wildcard The wildcard to retrieve the directory from.
+*/
+void cbrew_wildcard_directory(char* dir, const char* wildcard);
+
+/**
+* Searches for a file that matches a wildcard and has been modified after a given time.
+* @param wildcard The wildcard that the file must match.
+* @param mtime The modification time that the file must be newer than.
+* @param newer_filepath A string large enough to store the filepath of the newer file, which is only set if a newer file has been found.
+* @return Returns CBREW_TRUE if a newer file has been found, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_wildcard_find_newer_file(const char* wildcard, uint64_t mtime, char* newer_filepath);
+
+/**
+ * Checks whether or not a filepath matches a given wildcard.
+ * @param filepath The filepath to match against.
+ * @param wildcard The wildcard that will be matched against.
+ * @return Returns CBREW_TRUE if the filepath matches the wildcard, CBREW_FALSE otherwise.
+ */
+CbrewBool cbrew_file_matches_wildcard(const char* filepath, const char* wildcard);
+
+/**
+* Scans a directory for all files and returns an array of strings containing the filenames.
+* @param dir The directory to scan for files.
+* @param files_count A pointer whose value will be set to the amount of files found. If NULL, no count will be set.
+* @return Returns a string array of the found files or NULL if no files were found. The individual strings as well as the array itself needs to be freed by the caller.
+*/
+char** cbrew_find_files(const char* dir, size_t* files_count);
+
+/**
+* Scans a directory and all subdirectories for all files and returns an array of strings containing the filenames.
+* @param dir The directory to scan for files.
+* @param files_count A pointer whose value will be set to the amount of files found. If NULL, no count will be set.
+* @return Returns a string array of the found files or NULL if no files were found. The individual strings as well as the array itself needs to be freed by the caller.
+*/
+char** cbrew_find_files_recursive(const char* dir, size_t* files_count);
+
+/**
+* Checks if a directory exists.
+* @param dir The path of the directory.
+* @return Returns CBREW_TRUE if the directory exists, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_dir_exists(const char* dir);
+
+/**
+* Creates a new directory.
+* @param dir The path of the directory which will be created.
+* @return Returns CBREW_TRUE if the directory could be created, CBREW_FALSE otherwise.
+*/
+CbrewBool cbrew_dir_create(const char* dir);
+
+#ifdef CBREW_IMPLEMENTATION
+
+#define CBREW_ARENA_BLOCK_SIZE (64 * 1024)
+#define CBREW_ARENA_ALIGNMENT 16
+
+typedef struct CbrewHandler
+{
+    CbrewArena arena;
+
+    const char** strings;
+    size_t strings_count;
+    size_t strings_capacity;
+
+    CbrewProject** projects;
+    size_t projects_count;
+    size_t projects_capacity;
+
+    CbrewToolchain** toolchains;
+    size_t toolchains_count;
+    size_t toolchains_capacity;
+    CbrewToolchain* default_toolchain;
+    char* toolchain_name;
+
+    char** targets;
+    size_t targets_count;
+
+    const CbrewConfig** selected_configs;
+    size_t selected_configs_count;
+
+    size_t jobs;
+
+    size_t memory_limit;
+    double load_limit;
+    CbrewBool keep_going;
+    CbrewBool dry_run;
+    CbrewBool explain;
+    CbrewBool prune_stale;
+    CbrewCleanMode clean_mode;
+    CbrewBool run_tests;
+    CbrewBool run_benchmarks;
+    size_t shard_index;
+    size_t shard_count;
+    CbrewBool args_parsed;
+
+    size_t progress_len;
+
+    CbrewJobserver jobserver;
+    CbrewBool jobserver_initialized;
+
+    CbrewHistory history;
+    CbrewBool history_loaded;
+
+    CbrewIncludeCache include_cache;
+    CbrewBool include_cache_loaded;
+} CbrewHandler;
+
+#define CBREW_HISTORY_FILEPATH ".cbrew" CBREW_PATH_SEPARATOR_STR "history"
+#define CBREW_INCLUDE_CACHE_FILEPATH ".cbrew" CBREW_PATH_SEPARATOR_STR "includes"
+#define CBREW_TOOLCHAIN_CACHE_FILEPATH ".cbrew" CBREW_PATH_SEPARATOR_STR "toolchains"
+#define CBREW_DEFAULT_TEST_TIMEOUT 300
+#define CBREW_BENCHMARKS_FILEPATH ".cbrew" CBREW_PATH_SEPARATOR_STR "benchmarks"
+#define CBREW_DEFAULT_BENCHMARK_SAMPLES 10
+#define CBREW_DEFAULT_BENCHMARK_WARN_THRESHOLD 5.0
+#define CBREW_BENCHMARK_BASELINE_RUNS 5
+#define CBREW_STATS_FILEPATH ".cbrew" CBREW_PATH_SEPARATOR_STR "stats"
+#define CBREW_STATS_MAX_RECORDS 1000
+#define CBREW_STATS_TRAILING_RECORDS 20
+#define CBREW_STATS_SLOW_FACTOR 1.25
+
+static CbrewHandler handler;
+
+void cbrew_build(void)
+{
+    const double start = cbrew_time_ms();
+
+    cbrew_parse_args();
+
+    if(handler.toolchain_name != NULL && cbrew_toolchain_find(handler.toolchain_name) == NULL)
+    {
+        CBREW_LOG_ERROR("Toolchain with name %s doesn't exist!", handler.toolchain_name);
+
+        cbrew_free();
+
+        exit(EXIT_FAILURE);
+    }
+
+    if(!cbrew_select_targets())
+    {
+        cbrew_free();
+
+        exit(EXIT_FAILURE);
+    }
+
+    // Only creating and running the actions is recorded, as selecting targets and logging the results hardly depend on the build
+    const double actions_start = cbrew_time_ms();
+
+    CbrewBool success = CBREW_TRUE;
+
+    CbrewGraph graph;
+    memset(&graph, 0, sizeof(CbrewGraph));
+
+    for(size_t i = 0; i < handler.projects_count; ++i)
+    {
+        if(!cbrew_project_add_actions(&graph, handler.projects[i]))
+            success = CBREW_FALSE;
+    }
+
+    cbrew_graph_add_link_dependencies(&graph);
+
+    if(cbrew_get_clean_mode() != CBREW_CLEAN_MODE_NONE)
+    {
+        size_t deleted_count = 0;
+
+        for(size_t i = 0; i < handler.projects_count; ++i)
+        {
+            const CbrewProject* project = handler.projects[i];
+
+            for(size_t j = 0; j < project->configs_count; ++j)
+            {
+                if(cbrew_config_is_selected(project->configs[j]))
+                    deleted_count += cbrew_project_config_update_manifest(&graph, project, project->configs[j], cbrew_get_clean_mode());
+            }
+        }
+
+        CBREW_LOG_INFO("%s %zu files", cbrew_get_dry_run() ? "Would delete" : "Deleted", deleted_count);
+
+        cbrew_graph_free(&graph);
+
+        cbrew_free();
+
+        return;
+    }
+
+    const double run_start = cbrew_time_ms();
+
+    cbrew_graph_run(&graph);
+
+    const double run_time = cbrew_time_ms() - run_start;
+    const double actions_time = cbrew_time_ms() - actions_start;
+
+    if(cbrew_get_dry_run())
+    {
+        size_t planned_count = 0;
+        for(size_t i = 0; i < graph.actions_count; ++i)
+        {
+            if(graph.actions[i].state == CBREW_ACTION_STATE_SUCCEEDED)
+                ++planned_count;
+        }
+
+        CBREW_LOG_INFO("Dry run: %zu of %zu actions would be run", planned_count, graph.actions_count);
+
+        cbrew_graph_free(&graph);
+
+        cbrew_free();
+
+        return;
+    }
+
+    for(size_t i = 0; i < handler.projects_count; ++i)
+    {
+        if(!cbrew_project_log_result(&graph, handler.projects[i]))
+            success = CBREW_FALSE;
+    }
+
+    cbrew_graph_log_failures(&graph);
+
+    cbrew_graph_log_critical_path(&graph, run_time);
+
+    // Configs without any action have not been built, so their files are kept
+    for(size_t i = 0; i < handler.projects_count; ++i)
+    {
+        const CbrewProject* project = handler.projects[i];
+
+        for(size_t j = 0; j < project->configs_count; ++j)
+        {
+            const CbrewConfig* config = project->configs[j];
+
+            CbrewBool config_has_actions = CBREW_FALSE;
+            for(size_t k = 0; k < graph.actions_count && !config_has_actions; ++k)
+                config_has_actions = graph.actions[k].config == config;
+
+            if(config_has_actions)
+                cbrew_project_config_update_manifest(&graph, project, config, cbrew_get_prune_stale() ? CBREW_CLEAN_MODE_STALE : CBREW_CLEAN_MODE_NONE);
+        }
+    }
+
+    cbrew_graph_record_stats(&graph, actions_time, success);
+
+    cbrew_graph_free(&graph);
+
+    cbrew_free();
+
+    const double building_time = cbrew_time_ms() - start;
+
+    if(success)
+        CBREW_LOG_INFO("Successfully built all projects %s(%.0lfms)", CBREW_CONSOLE_COLOR_TIME, building_time);
+    else
+    {
+        CBREW_LOG_ERROR("Build process finished with errors! %s(%.0lfms)", CBREW_CONSOLE_COLOR_TIME, building_time);
+
+        // main() of cbrew.c usually returns 0 no matter what, so the failure has to be reported here
+        exit(EXIT_FAILURE);
+    }
+}
+
+void cbrew_free(void)
+{
+    cbrew_arena_free(&handler.arena);
+
+    free(handler.strings);
+
+    handler.strings = NULL;
+    handler.strings_count = 0;
+    handler.strings_capacity = 0;
+
+    handler.projects = NULL;
+    handler.projects_count = 0;
+    handler.projects_capacity = 0;
+
+    handler.toolchains = NULL;
+    handler.toolchains_count = 0;
+    handler.toolchains_capacity = 0;
+    handler.default_toolchain = NULL;
+
+    free(handler.selected_configs);
+    handler.selected_configs = NULL;
+    handler.selected_configs_count = 0;
+
+    cbrew_history_free(&handler.history);
+    handler.history_loaded = CBREW_FALSE;
+
+    cbrew_include_cache_free(&handler.include_cache);
+    handler.include_cache_loaded = CBREW_FALSE;
+}
+
+void cbrew_set_jobs(size_t jobs)
+{
+    handler.jobs = jobs;
+}
+
+size_t cbrew_get_jobs(void)
+{
+    size_t jobs = handler.jobs;
+
+    if(jobs == 0)
+    {
+        const char* jobs_env = getenv("CBREW_JOBS");
+        if(jobs_env != NULL)
+            jobs = strtoul(jobs_env, NULL, 10);
+    }
+
+    if(jobs == 0)
+        jobs = cbrew_processor_count();
+
+#ifdef CBREW_PLATFORM_WINDOWS
+    if(jobs > MAXIMUM_WAIT_OBJECTS)
+        jobs = MAXIMUM_WAIT_OBJECTS;
+#endif
+
+    return jobs;
+}
+
+void cbrew_set_memory_limit(size_t megabytes)
+{
+    handler.memory_limit = megabytes;
+}
+
+size_t cbrew_get_memory_limit(void)
+{
+    size_t memory_limit = handler.memory_limit;
+
+    if(memory_limit == 0)
+    {
+        const char* memory_limit_env = getenv("CBREW_MEMORY_LIMIT");
+        if(memory_limit_env != NULL)
+            memory_limit = strtoul(memory_limit_env, NULL, 10);
+    }
+
+    return memory_limit;
+}
+
+void cbrew_set_load_limit(double load)
+{
+    handler.load_limit = load;
+}
+
+double cbrew_get_load_limit(void)
+{
+    double load_limit = handler.load_limit;
+
+    if(load_limit <= 0.0)
+    {
+        const char* load_limit_env = getenv("CBREW_LOAD_LIMIT");
+        if(load_limit_env != NULL)
+            load_limit = strtod(load_limit_env, NULL);
+    }
+
+    return load_limit > 0.0 ? load_limit : 0.0;
+}
+
+void cbrew_set_keep_going(CbrewBool keep_going)
+{
+    handler.keep_going = keep_going;
+}
+
+CbrewBool cbrew_get_keep_going(void)
+{
+    return handler.keep_going;
+}
+
+void cbrew_set_dry_run(CbrewBool dry_run)
+{
+    handler.dry_run = dry_run;
+}
+
+CbrewBool cbrew_get_dry_run(void)
+{
+    return handler.dry_run;
+}
+
+void cbrew_set_explain(CbrewBool explain)
+{
+    handler.explain = explain;
+}
+
+CbrewBool cbrew_get_explain(void)
+{
+    return handler.explain;
+}
+
+void cbrew_set_prune_stale(CbrewBool prune_stale)
+{
+    handler.prune_stale = prune_stale;
+}
+
+void cbrew_set_run_tests(CbrewBool run_tests)
+{
+    handler.run_tests = run_tests;
+}
+
+CbrewBool cbrew_get_run_tests(void)
+{
+    return handler.run_tests;
+}
+
+void cbrew_set_run_benchmarks(CbrewBool run_benchmarks)
+{
+    handler.run_benchmarks = run_benchmarks;
+}
+
+CbrewBool cbrew_get_run_benchmarks(void)
+{
+    return handler.run_benchmarks;
+}
+
+void cbrew_set_shard(size_t index, size_t count)
+{
+    CBREW_ASSERT(count == 0 || (index >= 1 && index <= count));
+
+    handler.shard_index = index;
+    handler.shard_count = count;
+}
+
+void cbrew_add_target(const char* target)
+{
+    CBREW_ASSERT(target != NULL);
+
+    // Targets have to outlive cbrew_free(), like the toolchain name
+    handler.targets = realloc(handler.targets, (handler.targets_count + 1) * sizeof(char*));
+    handler.targets[handler.targets_count++] = strdup(target);
+}
+
+CbrewBool cbrew_select_targets(void)
+{
+    free(handler.selected_configs);
+    handler.selected_configs = NULL;
+    handler.selected_configs_count = 0;
+
+    if(handler.targets_count == 0)
+        return CBREW_TRUE;
+
+    // Every config is selected at most once, so the array never needs to grow
+    size_t configs_count = 0;
+    for(size_t i = 0; i < handler.projects_count; ++i)
+        configs_count += handler.projects[i]->configs_count;
+
+    handler.selected_configs = malloc((configs_count + 1) * sizeof(CbrewConfig*));
+
+    for(size_t i = 0; i < handler.targets_count; ++i)
+    {
+        const char* target = handler.targets[i];
+        const char* separator = strchr(target, ':');
+        const int project_name_len = separator != NULL ? (int) (separator - target) : (int) strlen(target);
+
+        const CbrewProject* project = NULL;
+        for(size_t j = 0; j < handler.projects_count && project == NULL; ++j)
+        {
+            if(strncmp(handler.projects[j]->name, target, project_name_len) == 0 && handler.projects[j]->name[project_name_len] == '\0')
+                project = handler.projects[j];
+        }
+
+        if(project == NULL)
+        {
+            CBREW_LOG_ERROR("Project with name %.*s doesn't exist!", project_name_len, target);
+            return CBREW_FALSE;
+        }
+
+        CbrewBool found = CBREW_FALSE;
+
+        for(size_t j = 0; j < project->configs_count; ++j)
+        {
+            const CbrewConfig* config = project->configs[j];
+
+            if(separator != NULL && strcmp(config->name, separator + 1) != 0)
+                continue;
+
+            found = CBREW_TRUE;
+
+            if(!cbrew_config_is_selected(config))
+                handler.selected_configs[handler.selected_configs_count++] = config;
+        }
+
+        if(!found && separator == NULL)
+        {
+            CBREW_LOG_ERROR("Project %s%s %shas no configs to build!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_ERROR);
+            return CBREW_FALSE;
+        }
+
+        if(!found)
+        {
+            CBREW_LOG_ERROR("Config with name %s doesn't exist for project %s%s%s!", separator + 1, CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_ERROR);
+            return CBREW_FALSE;
+        }
+    }
+
+    // Links belong to the project, so the links of every selected project are only followed once
+    CbrewBool* linked_projects = calloc(handler.projects_count + 1, sizeof(CbrewBool));
+
+    // The products that selected configs link against are selected as well, until nothing new is found
+    for(size_t i = 0; i < handler.selected_configs_count; ++i)
+    {
+        size_t project_index = handler.projects_count;
+        for(size_t j = 0; j < handler.projects_count && project_index == handler.projects_count; ++j)
+        {
+            for(size_t k = 0; k < handler.projects[j]->configs_count && project_index == handler.projects_count; ++k)
+            {
+                if(handler.projects[j]->configs[k] == handler.selected_configs[i])
+                    project_index = j;
+            }
+        }
+
+        if(linked_projects[project_index])
+            continue;
+
+        linked_projects[project_index] = CBREW_TRUE;
+
+        const CbrewProject* project = handler.projects[project_index];
+
+        for(size_t j = 0; j < project->links_count; ++j)
+        {
+            const char* link = project->links[j];
+            const CbrewConfig* config = cbrew_link_find_config(link);
+
+            // Libraries without a directory are found by the linker inside the system directories
+            if(config == NULL && strchr(link, CBREW_PATH_SEPARATOR) != NULL)
+                CBREW_LOG_WARN("Link %s of project %s%s %sdoesn't match the product of any library project, so nothing is built for it!", link, CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+
+            if(config != NULL && !cbrew_config_is_selected(config))
+                handler.selected_configs[handler.selected_configs_count++] = config;
+        }
+    }
+
+    free(linked_projects);
+
+    return CBREW_TRUE;
+}
+
+CbrewBool cbrew_config_is_selected(const CbrewConfig* config)
+{
+    CBREW_ASSERT(config != NULL);
+
+    if(handler.targets_count == 0)
+        return CBREW_TRUE;
+
+    for(size_t i = 0; i < handler.selected_configs_count; ++i)
+    {
+        if(handler.selected_configs[i] == config)
+            return CBREW_TRUE;
+    }
+
+    return CBREW_FALSE;
+}
+
+const CbrewConfig* cbrew_link_find_config(const char* link)
+{
+    CBREW_ASSERT(link != NULL);
+
+    // Links and target directories may be written with or without "./" and trailing path separators
+    char link_path[CBREW_FILEPATH_MAX];
+    cbrew_normalized_path(link_path, link);
+
+    for(size_t i = 0; i < handler.projects_count; ++i)
+    {
+        const CbrewProject* project = handler.projects[i];
+
+        if(project->type != CBREW_PROJECT_TYPE_STATIC_LIB && project->type != CBREW_PROJECT_TYPE_DYNAMIC_LIB)
+            continue;
+
+        for(size_t j = 0; j < project->configs_count; ++j)
+        {
+            char product_filepath[CBREW_FILEPATH_MAX];
+            sprintf(product_filepath, "%s%c%s", project->configs[j]->target_dir, CBREW_PATH_SEPARATOR, project->name);
+
+            char product_path[CBREW_FILEPATH_MAX];
+            cbrew_normalized_path(product_path, product_filepath);
+
+            if(strcmp(product_path, link_path) == 0)
+                return project->configs[j];
+        }
+    }
+
+    return NULL;
+}
+
+CbrewBool cbrew_file_is_in_shard(const char* filepath)
+{
+    CBREW_ASSERT(filepath != NULL);
+
+    if(handler.shard_count == 0)
+        return CBREW_TRUE;
+
+    return cbrew_hash_str(filepath) % handler.shard_count == handler.shard_index - 1;
+}
+
+CbrewBool cbrew_get_prune_stale(void)
+{
+    return handler.prune_stale;
+}
+
+void cbrew_set_clean_mode(CbrewCleanMode clean_mode)
+{
+    CBREW_ASSERT(clean_mode < CBREW_CLEAN_MODE_SIZE);
+
+    handler.clean_mode = clean_mode;
+}
+
+CbrewCleanMode cbrew_get_clean_mode(void)
+{
+    return handler.clean_mode;
+}
+
+void cbrew_parse_args(void)
+{
+    if(handler.args_parsed)
+        return;
+
+    handler.args_parsed = CBREW_TRUE;
+
+    size_t args_count = 0;
+    char** args = cbrew_command_line_args(&args_count);
+
+    CbrewBool build = CBREW_FALSE;
+    CbrewBool clean = CBREW_FALSE;
+    CbrewBool stale = CBREW_FALSE;
+
+    for(size_t i = 0; i < args_count; ++i)
+    {
+        const char* arg = args[i];
+
+        if(strcmp(arg, "-k") == 0 || strcmp(arg, "--keep-going") == 0)
+            handler.keep_going = CBREW_TRUE;
+        else if(strcmp(arg, "-n") == 0 || strcmp(arg, "--dry-run") == 0)
+            handler.dry_run = CBREW_TRUE;
+        else if(strcmp(arg, "--explain") == 0)
+            handler.explain = CBREW_TRUE;
+        else if(strcmp(arg, "--prune-stale") == 0)
+            handler.prune_stale = CBREW_TRUE;
+        else if(strncmp(arg, "--toolchain=", 12) == 0)
+        {
+            // The name has to outlive cbrew_free(), since the arguments are parsed only once
+            free(handler.toolchain_name);
+            handler.toolchain_name = strdup(arg + 12);
+        }
+        else if(i == 0 && strcmp(arg, "build") == 0)
+            build = CBREW_TRUE;
+        else if(i == 0 && strcmp(arg, "clean") == 0)
+            clean = CBREW_TRUE;
+        else if(i == 0 && strcmp(arg, "test") == 0)
+            handler.run_tests = CBREW_TRUE;
+        else if(i == 0 && strcmp(arg, "bench") == 0)
+            handler.run_benchmarks = CBREW_TRUE;
+        else if(strcmp(arg, "--shard") == 0 || strncmp(arg, "--shard=", 8) == 0)
+        {
+            const char* shard = arg[7] == '=' ? arg + 8 : (i + 1 < args_count ? args[++i] : "");
+
+            size_t index = 0;
+            size_t count = 0;
+
+            if(sscanf(shard, "%zu/%zu", &index, &count) == 2 && index >= 1 && index <= count)
+                cbrew_set_shard(index, count);
+            else
+                CBREW_LOG_WARN("Ignoring invalid shard %s, expected <index>/<count>!", shard);
+        }
+        else if(clean && strcmp(arg, "--stale") == 0)
+            stale = CBREW_TRUE;
+        else if(i > 0 && arg[0] != '-' && (build || clean || handler.run_tests || handler.run_benchmarks))
+            cbrew_add_target(arg);
+        else
+            CBREW_LOG_WARN("Ignoring unknown argument %s!", arg);
+    }
+
+    if(clean)
+        handler.clean_mode = stale ? CBREW_CLEAN_MODE_STALE : CBREW_CLEAN_MODE_ALL;
+
+    for(size_t i = 0; i < args_count; ++i)
+        free(args[i]);
+
+    free(args);
+}
+
+void cbrew_log_progress(size_t current, size_t total, const CbrewAction* action)
+{
+    CBREW_ASSERT(action != NULL);
+
+    const char* verb = "";
+    char target[CBREW_FILEPATH_MAX];
+
+    switch(action->type)
+    {
+        case CBREW_ACTION_TYPE_COMPILE: verb = "compiling"; strcpy(target, action->input); break;
+        case CBREW_ACTION_TYPE_LINK: verb = "linking"; cbrew_action_output_filepath(target, action); break;
+        case CBREW_ACTION_TYPE_STATIC_LIB: verb = "archiving"; cbrew_action_output_filepath(target, action); break;
+        case CBREW_ACTION_TYPE_DYNAMIC_LIB: verb = "linking"; cbrew_action_output_filepath(target, action); break;
+        case CBREW_ACTION_TYPE_INSTALL: verb = "installing"; strcpy(target, action->destination); break;
+        case CBREW_ACTION_TYPE_SHARE: verb = "sharing"; strcpy(target, action->destination); break;
+        case CBREW_ACTION_TYPE_TEST: verb = "testing"; cbrew_config_test_filepath(target, action->config, action->input); break;
+        case CBREW_ACTION_TYPE_BENCHMARK: verb = "benchmarking"; cbrew_config_test_filepath(target, action->config, action->input); break;
+        case CBREW_ACTION_TYPE_STEP: verb = "generating"; strcpy(target, action->step->name); break;
+        default: CBREW_ASSERT(CBREW_FALSE);
+    }
+
+    char line[CBREW_FILEPATH_MAX + 64];
+    int len = snprintf(line, sizeof(line), "[%zu/%zu] %s %s", current, total, verb, target);
+
+    if(len < 0)
+        return;
+
+    // A dry run logs the command below every progress, so it must not be replaced
+    if(!cbrew_console_is_interactive() || cbrew_get_dry_run())
+    {
+        printf("%s\n", line);
+        return;
+    }
+
+    // A wrapped line can't be replaced anymore, so long paths are shortened at their beginning
+    const int max_len = 79;
+    if(len > max_len)
+    {
+        const int prefix_len = snprintf(line, sizeof(line), "[%zu/%zu] %s ...", current, total, verb);
+        const size_t target_len = strlen(target);
+        const size_t kept_len = max_len > prefix_len ? (size_t) (max_len - prefix_len) : 0;
+
+        strcat(line, target + (target_len > kept_len ? target_len - kept_len : 0));
+        len = (int) strlen(line);
+    }
+
+    // Spaces overwrite the rest of a longer previous progress, as not every console understands escape sequences
+    const int padding = handler.progress_len > (size_t) len ? (int) handler.progress_len - len : 0;
+    printf("\r%s%*s", line, padding, "");
+    fflush(stdout);
+
+    handler.progress_len = (size_t) len;
+}
+
+void cbrew_log_progress_clear(void)
+{
+    if(handler.progress_len == 0)
+        return;
+
+    printf("\r%*s\r", (int) handler.progress_len, "");
+    fflush(stdout);
+
+    handler.progress_len = 0;
+}
+
+/* Projects */
+
+CbrewProject* cbrew_project_create(const char* name, CbrewProjectType type)
+{
+    CBREW_ASSERT(name != NULL);
+    CBREW_ASSERT(type < CBREW_PROJECT_TYPE_SIZE);
+
+    name = cbrew_intern(name);
+
+    for(size_t i = 0; i < handler.projects_count; ++i)
+    {
+        if(handler.projects[i]->name == name)
+        {
+            CBREW_LOG_WARN("Project with name %s%s%s already exists!", CBREW_CONSOLE_COLOR_PROJECT, name, CBREW_CONSOLE_COLOR_WARN);
+            return handler.projects[i];
+        }
+    }
+
+    CbrewProject* project = cbrew_arena_alloc(&handler.arena, sizeof(CbrewProject));
+
+    project->name = name;
+    project->type = type;
+    project->test_timeout = CBREW_DEFAULT_TEST_TIMEOUT;
+    project->benchmark_samples = CBREW_DEFAULT_BENCHMARK_SAMPLES;
+    project->benchmark_warn_threshold = CBREW_DEFAULT_BENCHMARK_WARN_THRESHOLD;
+
+    handler.projects = cbrew_arena_array_grow(&handler.arena, handler.projects, handler.projects_count, &handler.projects_capacity, sizeof(CbrewProject*));
+    handler.projects[handler.projects_count++] = project;
+
+    return project;
+}
+
+void cbrew_project_add_files(CbrewProject* project, const char* wildcard)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(wildcard != NULL);
+
+    project->wildcards = cbrew_arena_array_grow(&handler.arena, project->wildcards, project->wildcards_count, &project->wildcards_capacity, sizeof(char*));
+    project->wildcards[project->wildcards_count++] = cbrew_intern_path(wildcard);
+}
+
+void cbrew_project_add_flag(CbrewProject* project, const char* flag)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(flag != NULL);
+
+    project->flags = cbrew_arena_array_grow(&handler.arena, project->flags, project->flags_count, &project->flags_capacity, sizeof(char*));
+    project->flags[project->flags_count++] = cbrew_intern(flag);
+}
+
+void cbrew_project_add_define(CbrewProject* project, const char* define)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(define != NULL);
+
+    project->defines = cbrew_arena_array_grow(&handler.arena, project->defines, project->defines_count, &project->defines_capacity, sizeof(char*));
+    project->defines[project->defines_count++] = cbrew_intern(define);
+}
+
+void cbrew_project_add_include_dir(CbrewProject* project, const char* include_dir)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(include_dir != NULL);
+
+    project->include_dirs = cbrew_arena_array_grow(&handler.arena, project->include_dirs, project->include_dirs_count, &project->include_dirs_capacity, sizeof(char*));
+    project->include_dirs[project->include_dirs_count++] = cbrew_intern_path(include_dir);
+}
+
+void cbrew_project_add_link(CbrewProject* project, const char* link)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(link != NULL);
+
+    // The name of the library follows the last path separator, so trailing separators are removed
+    char link_path[CBREW_FILEPATH_MAX];
+    strcpy(link_path, link);
+
+    size_t link_len = strlen(link_path);
+    while(link_len > 1 && (link_path[link_len - 1] == '/' || link_path[link_len - 1] == '\\'))
+        link_path[--link_len] = '\0';
+
+    project->links = cbrew_arena_array_grow(&handler.arena, project->links, project->links_count, &project->links_capacity, sizeof(char*));
+    project->links[project->links_count++] = cbrew_intern_path(link_path);
+}
+
+void cbrew_project_add_install_headers(CbrewProject* project, const char* wildcard)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(wildcard != NULL);
+
+    project->install_headers = cbrew_arena_array_grow(&handler.arena, project->install_headers, project->install_headers_count, &project->install_headers_capacity, sizeof(char*));
+    project->install_headers[project->install_headers_count++] = cbrew_intern_path(wildcard);
+}
+
+void cbrew_project_set_test_timeout(CbrewProject* project, size_t seconds)
+{
+    CBREW_ASSERT(project != NULL);
+
+    project->test_timeout = seconds;
+}
+
+void cbrew_project_add_test_inputs(CbrewProject* project, const char* wildcard)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(wildcard != NULL);
+
+    project->test_inputs = cbrew_arena_array_grow(&handler.arena, project->test_inputs, project->test_inputs_count, &project->test_inputs_capacity, sizeof(char*));
+    project->test_inputs[project->test_inputs_count++] = cbrew_intern_path(wildcard);
+}
+
+void cbrew_project_set_benchmark_samples(CbrewProject* project, size_t samples)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(samples > 0);
+
+    project->benchmark_samples = samples;
+}
+
+void cbrew_project_set_benchmark_thresholds(CbrewProject* project, double warn_percent, double fail_percent)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(warn_percent >= 0.0 && fail_percent >= 0.0);
+
+    project->benchmark_warn_threshold = warn_percent;
+    project->benchmark_fail_threshold = fail_percent;
+}
+
+void cbrew_project_add_file_flag(CbrewProject* project, const char* wildcard, const char* flag, CbrewBool remove)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(wildcard != NULL);
+    CBREW_ASSERT(flag != NULL);
+
+    project->file_flags = cbrew_arena_array_grow(&handler.arena, project->file_flags, project->file_flags_count, &project->file_flags_capacity, sizeof(CbrewFileFlag));
+
+    CbrewFileFlag* file_flag = &project->file_flags[project->file_flags_count++];
+    file_flag->wildcard = cbrew_intern_path(wildcard);
+    file_flag->flag = cbrew_intern(flag);
+    file_flag->remove = remove;
+}
+
+CbrewBool cbrew_file_flag_matches(const CbrewFileFlag* file_flag, const char* filepath)
+{
+    CBREW_ASSERT(file_flag != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    if(cbrew_file_matches_wildcard(filepath, file_flag->wildcard))
+        return CBREW_TRUE;
+
+    // Source files are found inside ".", but wildcards without the leading "./" should match them as well
+    return filepath[0] == '.' && filepath[1] == CBREW_PATH_SEPARATOR && cbrew_file_matches_wildcard(filepath + 2, file_flag->wildcard);
+}
+
+CbrewBool cbrew_project_file_has_flags(const CbrewProject* project, const char* filepath)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    for(size_t i = 0; i < project->file_flags_count; ++i)
+    {
+        if(cbrew_file_flag_matches(&project->file_flags[i], filepath))
+            return CBREW_TRUE;
+    }
+
+    return CBREW_FALSE;
+}
+
+const char** cbrew_project_config_flags(const CbrewProject* project, const CbrewConfig* config, const char* filepath, size_t* flags_count)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(flags_count != NULL);
+
+    const char** flags = malloc((project->flags_count + config->flags_count + project->file_flags_count + 1) * sizeof(char*));
+    size_t flags_found = 0;
+
+    for(size_t i = 0; i < project->flags_count; ++i)
+        flags[flags_found++] = project->flags[i];
+
+    for(size_t i = 0; i < config->flags_count; ++i)
+        flags[flags_found++] = config->flags[i];
+
+    for(size_t i = 0; i < project->file_flags_count && filepath != NULL; ++i)
+    {
+        const CbrewFileFlag* file_flag = &project->file_flags[i];
+
+        if(!file_flag->remove && cbrew_file_flag_matches(file_flag, filepath))
+            flags[flags_found++] = file_flag->flag;
+    }
+
+    // Removed flags win over added flags, no matter in which order they were specified
+    for(size_t i = 0; i < project->file_flags_count && filepath != NULL; ++i)
+    {
+        const CbrewFileFlag* file_flag = &project->file_flags[i];
+
+        if(!file_flag->remove || !cbrew_file_flag_matches(file_flag, filepath))
+            continue;
+
+        size_t kept_count = 0;
+        for(size_t j = 0; j < flags_found; ++j)
+        {
+            if(strcmp(flags[j], file_flag->flag) != 0)
+                flags[kept_count++] = flags[j];
+        }
+
+        flags_found = kept_count;
+    }
+
+    *flags_count = flags_found;
+
+    return flags;
+}
+
+CbrewBool cbrew_project_config_splits_dwarf(const CbrewProject* project, const CbrewConfig* config, const CbrewToolchain* toolchain, const char* filepath)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(toolchain != NULL);
+
+    if(!config->fast_link || !(toolchain->capabilities & CBREW_TOOLCHAIN_CAPABILITY_SPLIT_DWARF))
+        return CBREW_FALSE;
+
+    size_t flags_count = 0;
+    const char** flags = cbrew_project_config_flags(project, config, filepath, &flags_count);
+
+    // Split debug information is only created together with debug information, so it's only expected if a -g flag is left
+    CbrewBool debug_info = CBREW_FALSE;
+    for(size_t i = 0; i < flags_count; ++i)
+    {
+        if(strncmp(flags[i], "-g", 2) == 0)
+            debug_info = strcmp(flags[i], "-g0") != 0;
+    }
+
+    free(flags);
+
+    return debug_info;
+}
+
+char* cbrew_project_config_compile_args(const CbrewProject* project, const CbrewConfig* config, const char* filepath, CbrewBool split_dwarf)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+
+    size_t flags_count = 0;
+    const char** flags = cbrew_project_config_flags(project, config, filepath, &flags_count);
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    cbrew_string_builder_append_include_dirs(&sb, project->include_dirs, project->include_dirs_count);
+    cbrew_string_builder_append_flags(&sb, flags, flags_count);
+    cbrew_string_builder_append_defines(&sb, project->defines, project->defines_count);
+    cbrew_string_builder_append_defines(&sb, config->defines, config->defines_count);
+    if(split_dwarf)
+        cbrew_string_builder_append(&sb, "-gsplit-dwarf ");
+
+    free(flags);
+
+    return cbrew_string_builder_release(&sb);
+}
+
+CbrewBool cbrew_project_file_matches_wildcards(const CbrewProject* project, const char* filepath)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    for(size_t i = 0; i < project->wildcards_count; ++i)
+    {
+        if(cbrew_file_matches_wildcard(filepath, project->wildcards[i]))
+            return CBREW_TRUE;
+    }
+
+    return CBREW_FALSE;
+}
+
+CbrewBool cbrew_project_file_is_step_output(const CbrewProject* project, const char* filepath)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    for(size_t i = 0; i < project->steps_count; ++i)
+    {
+        for(size_t j = 0; j < project->steps[i]->outputs_count; ++j)
+        {
+            if(strcmp(project->steps[i]->outputs[j], filepath) == 0)
+                return CBREW_TRUE;
+        }
+    }
+
+    return CBREW_FALSE;
+}
+
+char** cbrew_project_find_source_files(const CbrewProject* project, size_t* files_count)
+{
+    CBREW_ASSERT(project != NULL);
+
+    size_t files_found_count = 0;
+    char** files_found = cbrew_find_files_recursive(".", &files_found_count);
 
     size_t source_files_count = 0;
     for(size_t i = 0; i < files_found_count; ++i)
     {
-        if(cbrew_project_file_matches_wildcards(project, files_found[i]))
-            ++source_files_count;
+        if(cbrew_project_file_matches_wildcards(project, files_found[i]))
+            ++source_files_count;
+    }
+
+    if(files_count != NULL)
+        *files_count = source_files_count;
+
+    if(source_files_count == 0)
+    {
+        for(size_t i = 0; i < files_found_count; ++i)
+            free(files_found[i]);
+
+        free(files_found);
+
+        return NULL;
+    }
+
+    char** source_files = malloc(source_files_count * sizeof(char*));
+
+    size_t source_file_index = 0;
+    for(size_t i = 0; i < files_found_count; ++i)
+    {
+        if(cbrew_project_file_matches_wildcards(project, files_found[i]))
+            source_files[source_file_index++] = files_found[i];
+        else
+            free(files_found[i]);
+    }
+
+    free(files_found);
+
+    return source_files;
+}
+
+CbrewBool cbrew_project_build(const CbrewProject* project)
+{
+    CBREW_ASSERT(project != NULL);
+
+    CbrewGraph graph;
+    memset(&graph, 0, sizeof(CbrewGraph));
+
+    if(!cbrew_project_add_actions(&graph, project))
+    {
+        cbrew_graph_free(&graph);
+        return CBREW_FALSE;
+    }
+
+    cbrew_graph_run(&graph);
+
+    CbrewBool result = cbrew_project_log_result(&graph, project);
+
+    cbrew_graph_free(&graph);
+
+    return result;
+}
+
+CbrewBool cbrew_project_add_actions(CbrewGraph* graph, const CbrewProject* project)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(project != NULL);
+
+    // Projects that aren't built are skipped before their source files are searched
+    const CbrewConfig* first_config = NULL;
+    for(size_t i = 0; i < project->configs_count && first_config == NULL; ++i)
+    {
+        if(cbrew_config_is_selected(project->configs[i]))
+            first_config = project->configs[i];
+    }
+
+    if(first_config == NULL && project->configs_count > 0)
+        return CBREW_TRUE;
+
+    CBREW_LOG_TRACE("Building project %s%s%s...", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_TRACE);
+
+    if(project->configs_count == 0)
+    {
+        CBREW_LOG_WARN("Project %s%s %shas no configs!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+        CBREW_LOG_WARN("Skipping project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+        return CBREW_TRUE;
+    }
+
+    if(project->type >= CBREW_PROJECT_TYPE_SIZE)
+    {
+        CBREW_LOG_WARN("Invalid project type specified for project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+        CBREW_LOG_WARN("Skipping project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+        return CBREW_FALSE;
+    }
+
+    size_t project_files_count = 0;
+    char** project_files = cbrew_project_find_source_files(project, &project_files_count);
+
+    const size_t project_begin = graph->actions_count;
+
+    // Generated source files are compiled even if they don't exist yet, since their steps run before
+    for(size_t i = 0; i < project->steps_count; ++i)
+    {
+        const CbrewStep* step = project->steps[i];
+
+        if(step->outputs_count == 0)
+        {
+            CBREW_LOG_WARN("Build step %s of project %s%s %shas no outputs, skipping it!", step->name, CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+            continue;
+        }
+
+        cbrew_graph_add_step_action(graph, project, first_config, step);
+
+        for(size_t j = 0; j < step->outputs_count; ++j)
+        {
+            const char* output = step->outputs[j];
+
+            if(!cbrew_project_file_matches_wildcards(project, output))
+                continue;
+
+            CbrewBool found = CBREW_FALSE;
+            for(size_t k = 0; k < project_files_count && !found; ++k)
+                found = strcmp(project_files[k], output) == 0;
+
+            if(found)
+                continue;
+
+            project_files = realloc(project_files, (project_files_count + 1) * sizeof(char*));
+            project_files[project_files_count++] = strdup(output);
+        }
+    }
+
+    // Generated source files are found by the next search, so the files are sorted to keep the object files, and with them the commands of the products, in the same order
+    if(project_files_count > 1)
+        qsort(project_files, project_files_count, sizeof(char*), cbrew_str_compare);
+
+    const size_t steps_end = graph->actions_count;
+
+    // A step that reads the output of another step runs after it
+    for(size_t i = project_begin; i < steps_end; ++i)
+    {
+        const CbrewStep* step = graph->actions[i].step;
+
+        for(size_t j = project_begin; j < steps_end; ++j)
+        {
+            const CbrewStep* other_step = graph->actions[j].step;
+
+            CbrewBool reads_output = CBREW_FALSE;
+
+            for(size_t k = 0; k < step->inputs_count && i != j && !reads_output; ++k)
+            {
+                for(size_t l = 0; l < other_step->outputs_count && !reads_output; ++l)
+                    reads_output = cbrew_file_matches_wildcard(other_step->outputs[l], step->inputs[k]);
+            }
+
+            if(reads_output)
+                cbrew_graph_add_dependency(graph, i, j);
+        }
+    }
+
+    if(project_files_count == 0)
+    {
+        CBREW_LOG_WARN("Project %s%s %shas no source files!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+        CBREW_LOG_WARN("Skipping project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+        return CBREW_TRUE;
+    }
+
+    // Tests of other shards are neither built nor run
+    if(project->type == CBREW_PROJECT_TYPE_TEST)
+    {
+        size_t shard_files_count = 0;
+
+        for(size_t i = 0; i < project_files_count; ++i)
+        {
+            if(cbrew_file_is_in_shard(project_files[i]))
+                project_files[shard_files_count++] = project_files[i];
+            else
+                free(project_files[i]);
+        }
+
+        project_files_count = shard_files_count;
+    }
+
+    for(size_t i = 0; i < project->configs_count && project_files_count > 0; ++i)
+    {
+        if(cbrew_config_is_selected(project->configs[i]))
+            cbrew_project_config_add_actions(graph, project, project->configs[i], project_files, project_files_count);
+    }
+
+    // Generated headers may be included by any source file, so nothing is compiled before all steps have run
+    for(size_t i = steps_end; i < graph->actions_count; ++i)
+    {
+        if(graph->actions[i].type != CBREW_ACTION_TYPE_COMPILE)
+            continue;
+
+        for(size_t j = project_begin; j < steps_end; ++j)
+            cbrew_graph_add_dependency(graph, i, j);
+    }
+
+    cbrew_graph_share_compile_actions(graph, project_begin, graph->actions_count);
+
+    for(size_t i = 0; i < project_files_count; ++i)
+        free(project_files[i]);
+
+    free(project_files);
+
+    return CBREW_TRUE;
+}
+
+size_t cbrew_project_config_add_actions(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, char** project_files, size_t project_files_count)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(project_files != NULL);
+
+    if(!cbrew_get_dry_run() && cbrew_get_clean_mode() == CBREW_CLEAN_MODE_NONE)
+    {
+        if(!cbrew_dir_exists(config->obj_dir))
+            cbrew_dir_create(config->obj_dir);
+
+        if(!cbrew_dir_exists(config->target_dir))
+            cbrew_dir_create(config->target_dir);
+    }
+
+    const size_t compile_actions_begin = graph->actions_count;
+
+    for(size_t i = 0; i < project_files_count; ++i)
+    {
+        CBREW_ASSERT(project_files[i] != NULL);
+
+        // Up to date object files are detected while running the graph, since that requires the command of the action
+        cbrew_graph_add_action(graph, CBREW_ACTION_TYPE_COMPILE, project, config, project_files[i]);
+    }
+
+    const size_t compile_actions_end = graph->actions_count;
+
+    // Every test source file becomes an executable of its own, so one failing test never hides the results of the others
+    if(project->type == CBREW_PROJECT_TYPE_TEST || project->type == CBREW_PROJECT_TYPE_BENCHMARK)
+    {
+        size_t last_action = compile_actions_end - 1;
+
+        for(size_t i = 0; i < project_files_count; ++i)
+        {
+            const size_t link_action = cbrew_graph_add_action(graph, CBREW_ACTION_TYPE_LINK, project, config, project_files[i]);
+            cbrew_graph_add_dependency(graph, link_action, compile_actions_begin + i);
+
+            last_action = link_action;
+
+            if(project->type == CBREW_PROJECT_TYPE_TEST && cbrew_get_run_tests())
+            {
+                const size_t test_action = cbrew_graph_add_action(graph, CBREW_ACTION_TYPE_TEST, project, config, project_files[i]);
+                cbrew_graph_add_dependency(graph, test_action, link_action);
+            }
+            else if(project->type == CBREW_PROJECT_TYPE_BENCHMARK && cbrew_get_run_benchmarks())
+            {
+                const size_t benchmark_action = cbrew_graph_add_action(graph, CBREW_ACTION_TYPE_BENCHMARK, project, config, project_files[i]);
+                cbrew_graph_add_dependency(graph, benchmark_action, link_action);
+            }
+        }
+
+        return last_action;
+    }
+
+    CbrewActionType final_action_type = CBREW_ACTION_TYPE_LINK;
+
+    switch(project->type)
+    {
+        case CBREW_PROJECT_TYPE_APP: final_action_type = CBREW_ACTION_TYPE_LINK; break;
+        case CBREW_PROJECT_TYPE_STATIC_LIB: final_action_type = CBREW_ACTION_TYPE_STATIC_LIB; break;
+        case CBREW_PROJECT_TYPE_DYNAMIC_LIB: final_action_type = CBREW_ACTION_TYPE_DYNAMIC_LIB; break;
+        default: CBREW_ASSERT(CBREW_FALSE);
+    }
+
+    const size_t final_action = cbrew_graph_add_action(graph, final_action_type, project, config, NULL);
+
+    for(size_t i = compile_actions_begin; i < compile_actions_end; ++i)
+        cbrew_graph_add_dependency(graph, final_action, i);
+
+    if(config->install_dir != NULL)
+        cbrew_project_config_add_install_actions(graph, project, config, final_action);
+
+    return final_action;
+}
+
+void cbrew_project_config_add_install_actions(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, size_t final_action)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(config->install_dir != NULL);
+    CBREW_ASSERT(final_action < graph->actions_count);
+
+    char product_filepath[CBREW_FILEPATH_MAX];
+    cbrew_action_output_filepath(product_filepath, &graph->actions[final_action]);
+
+    const char* product_filename = strrchr(product_filepath, CBREW_PATH_SEPARATOR);
+    product_filename = product_filename == NULL ? product_filepath : product_filename + 1;
+
+    char destination[CBREW_FILEPATH_MAX];
+    if(snprintf(destination, sizeof(destination), "%s%c%s%c%s", config->install_dir, CBREW_PATH_SEPARATOR, project->type == CBREW_PROJECT_TYPE_APP ? "bin" : "lib", CBREW_PATH_SEPARATOR, product_filename) < (int) sizeof(destination))
+    {
+        const size_t install_action = cbrew_graph_add_install_action(graph, project, config, product_filepath, destination);
+        cbrew_graph_add_dependency(graph, install_action, final_action);
+    }
+    else
+        CBREW_LOG_ERROR("The install path of %s is too long!", product_filepath);
+
+    for(size_t i = 0; i < project->install_headers_count; ++i)
+    {
+        const char* wildcard = project->install_headers[i];
+
+        // Only the directory of the wildcard is searched, and its path is not part of the installed header's path
+        char dir[CBREW_FILEPATH_MAX];
+        cbrew_wildcard_directory(dir, wildcard);
+
+        size_t files_count = 0;
+        char** files = cbrew_find_files_recursive(dir, &files_count);
+
+        for(size_t j = 0; j < files_count; ++j)
+        {
+            if(cbrew_file_matches_wildcard(files[j], wildcard))
+            {
+                if(snprintf(destination, sizeof(destination), "%s%cinclude%c%s", config->install_dir, CBREW_PATH_SEPARATOR, CBREW_PATH_SEPARATOR, files[j] + strlen(dir) + 1) < (int) sizeof(destination))
+                    cbrew_graph_add_install_action(graph, project, config, files[j], destination);
+                else
+                    CBREW_LOG_ERROR("The install path of %s is too long!", files[j]);
+            }
+
+            free(files[j]);
+        }
+
+        free(files);
+    }
+}
+
+CbrewBool cbrew_project_log_result(const CbrewGraph* graph, const CbrewProject* project)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(project != NULL);
+
+    CbrewBool project_has_actions = CBREW_FALSE;
+    double project_start = 0.0;
+    double project_end = 0.0;
+
+    for(size_t i = 0; i < graph->actions_count; ++i)
+    {
+        const CbrewAction* action = &graph->actions[i];
+
+        if(action->project != project)
+            continue;
+
+        project_has_actions = CBREW_TRUE;
+
+        if(action->start_time == 0.0)
+            continue;
+
+        if(project_start == 0.0 || action->start_time < project_start)
+            project_start = action->start_time;
+
+        if(action->end_time > project_end)
+            project_end = action->end_time;
+    }
+
+    if(!project_has_actions)
+        return CBREW_TRUE;
+
+    CbrewBool project_success = CBREW_TRUE;
+
+    for(size_t i = 0; i < project->configs_count; ++i)
+    {
+        if(cbrew_config_is_selected(project->configs[i]) && !cbrew_project_config_log_result(graph, project, project->configs[i]))
+            project_success = CBREW_FALSE;
+    }
+
+    const double project_building_time = project_end - project_start;
+
+    if(project_success)
+    {
+        CBREW_LOG_INFO("Successfully built project %s%s %s(%.0lfms)", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_TIME, project_building_time);
+        return CBREW_TRUE;
+    }
+
+    CBREW_LOG_ERROR("Failed to build project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_ERROR);
+    return CBREW_FALSE;
+}
+
+CbrewBool cbrew_project_config_log_result(const CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+
+    CbrewBool steps_success = CBREW_TRUE;
+    CbrewBool compile_success = CBREW_TRUE;
+    CbrewBool config_success = CBREW_TRUE;
+
+    size_t tests_count = 0;
+    size_t failed_tests_count = 0;
+
+    size_t benchmarks_count = 0;
+    size_t failed_benchmarks_count = 0;
+
+    double config_start = 0.0;
+    double config_end = 0.0;
+
+    const CbrewAction* final_action = NULL;
+
+    for(size_t i = 0; i < graph->actions_count; ++i)
+    {
+        const CbrewAction* action = &graph->actions[i];
+
+        if(action->project != project || action->config != config)
+            continue;
+
+        const CbrewBool action_success = action->state == CBREW_ACTION_STATE_SUCCEEDED || action->state == CBREW_ACTION_STATE_UP_TO_DATE;
+
+        if(action->type == CBREW_ACTION_TYPE_COMPILE || action->type == CBREW_ACTION_TYPE_SHARE)
+        {
+            if(!action_success)
+                compile_success = CBREW_FALSE;
+        }
+        else if(action->type == CBREW_ACTION_TYPE_STEP)
+        {
+            if(!action_success)
+                steps_success = CBREW_FALSE;
+        }
+        else if(action->type == CBREW_ACTION_TYPE_TEST)
+        {
+            ++tests_count;
+
+            if(action->state == CBREW_ACTION_STATE_FAILED)
+                ++failed_tests_count;
+        }
+        else if(action->type == CBREW_ACTION_TYPE_BENCHMARK)
+        {
+            ++benchmarks_count;
+
+            if(action->state == CBREW_ACTION_STATE_FAILED)
+                ++failed_benchmarks_count;
+        }
+        else if(action->type != CBREW_ACTION_TYPE_INSTALL && (final_action == NULL || final_action->state != CBREW_ACTION_STATE_FAILED))
+            final_action = action;
+
+        if(!action_success)
+            config_success = CBREW_FALSE;
+
+        if(action->start_time == 0.0)
+            continue;
+
+        if(config_start == 0.0 || action->start_time < config_start)
+            config_start = action->start_time;
+
+        if(action->end_time > config_end)
+            config_end = action->end_time;
+    }
+
+    if(!steps_success)
+        CBREW_LOG_ERROR("Failed to run build steps for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
+    else if(!compile_success)
+        CBREW_LOG_ERROR("Failed to compile source files for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
+    else if(final_action != NULL && final_action->state == CBREW_ACTION_STATE_FAILED)
+    {
+        switch(final_action->type)
+        {
+            case CBREW_ACTION_TYPE_LINK: CBREW_LOG_ERROR("Failed to create executable for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR); break;
+            case CBREW_ACTION_TYPE_STATIC_LIB: CBREW_LOG_ERROR("Failed to create Static Lib for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR); break;
+            case CBREW_ACTION_TYPE_DYNAMIC_LIB: CBREW_LOG_ERROR("Failed to create Dynamic Lib for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR); break;
+            default: CBREW_ASSERT(CBREW_FALSE);
+        }
+    }
+
+    if(failed_tests_count > 0)
+        CBREW_LOG_ERROR("%zu of %zu tests failed for config %s%s%s!", failed_tests_count, tests_count, CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
+    else if(tests_count > 0 && config_success)
+        CBREW_LOG_INFO("All %zu tests passed for config %s%s", tests_count, CBREW_CONSOLE_COLOR_CONFIG, config->name);
+
+    if(failed_benchmarks_count > 0)
+        CBREW_LOG_ERROR("%zu of %zu benchmarks failed for config %s%s%s!", failed_benchmarks_count, benchmarks_count, CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
+
+    const double config_building_time = config_end - config_start;
+
+    if(config_success)
+        CBREW_LOG_INFO("Successfully built config %s%s %s(%.0lfms)", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_TIME, config_building_time);
+    else
+        CBREW_LOG_ERROR("Failed to build config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
+
+    return config_success;
+}
+
+CbrewBool cbrew_project_config_file_is_already_compiled(const CbrewProject* project, const CbrewConfig* config, const char* filepath)
+{
+    char obj_filepath[CBREW_FILEPATH_MAX];
+    cbrew_config_obj_filepath(obj_filepath, config, filepath);
+
+    if(!cbrew_file_exists(obj_filepath))
+        return CBREW_FALSE;
+
+    char* dependency_str = cbrew_project_config_file_dependencies(project, config, filepath);
+    if(dependency_str == NULL)
+        return CBREW_FALSE;
+
+    CbrewBool result = cbrew_file_is_newer_than_rule(obj_filepath, dependency_str, NULL);
+
+    free(dependency_str);
+
+    return result;
+}
+
+char* cbrew_project_config_file_dependencies(const CbrewProject* project, const CbrewConfig* config, const char* filepath)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    char dep_filepath[CBREW_FILEPATH_MAX];
+    cbrew_config_dep_filepath(dep_filepath, config, filepath);
+
+    // The dependency file is written while compiling, otherwise the compiler has to find the dependencies first
+    char* dependency_str = cbrew_file_read(dep_filepath, NULL);
+    if(dependency_str != NULL)
+        return dependency_str;
+
+    // Starting the preprocessor would take about as long as compiling the source file
+    char* dependencies = cbrew_project_scan_dependencies(project, filepath);
+    if(dependencies == NULL)
+        return NULL;
+
+    char obj_filepath[CBREW_FILEPATH_MAX];
+    cbrew_config_obj_filepath(obj_filepath, config, filepath);
+
+    dependency_str = cbrew_create_str("%s: %s\n", obj_filepath, dependencies);
+
+    free(dependencies);
+
+    return dependency_str;
+}
+
+char* cbrew_project_scan_dependencies(const CbrewProject* project, const char* filepath)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    if(!handler.include_cache_loaded)
+    {
+        cbrew_include_cache_load(&handler.include_cache, CBREW_INCLUDE_CACHE_FILEPATH);
+        handler.include_cache_loaded = CBREW_TRUE;
+    }
+
+    if(cbrew_include_cache_scan(&handler.include_cache, filepath) == NULL)
+        return NULL;
+
+    // Every found file is scanned once, in the order in which the files were found
+    char** files = malloc(sizeof(char*));
+    size_t files_count = 1;
+    size_t files_capacity = 1;
+
+    files[0] = strdup(filepath);
+
+    for(size_t i = 0; i < files_count; ++i)
+    {
+        const char* includes = cbrew_include_cache_scan(&handler.include_cache, files[i]);
+        if(includes == NULL)
+            continue;
+
+        char dir[CBREW_FILEPATH_MAX];
+        cbrew_path(strcpy(dir, files[i]));
+
+        char* last_path_separator = strrchr(dir, CBREW_PATH_SEPARATOR);
+        if(last_path_separator != NULL)
+            *last_path_separator = '\0';
+        else
+            strcpy(dir, ".");
+
+        for(const char* include = includes; *include != '\0';)
+        {
+            const char* include_end = strchr(include, '\n');
+            const size_t include_len = include_end == NULL ? strlen(include) : (size_t) (include_end - include);
+
+            char header[CBREW_FILEPATH_MAX];
+            snprintf(header, sizeof(header), "%.*s", include_len >= 2 ? (int) include_len - 2 : 0, include + 1);
+            cbrew_path(header);
+
+            char header_filepath[CBREW_FILEPATH_MAX];
+            CbrewBool found = CBREW_FALSE;
+
+            if(include[0] == '"')
+            {
+                if(snprintf(header_filepath, sizeof(header_filepath), "%s%c%s", dir, CBREW_PATH_SEPARATOR, header) < (int) sizeof(header_filepath))
+                    found = cbrew_file_mtime(header_filepath) != 0;
+            }
+
+            for(size_t j = 0; j < project->include_dirs_count && !found; ++j)
+            {
+                if(snprintf(header_filepath, sizeof(header_filepath), "%s%c%s", project->include_dirs[j], CBREW_PATH_SEPARATOR, header) < (int) sizeof(header_filepath))
+                    found = cbrew_file_mtime(header_filepath) != 0;
+            }
+
+            include = include_end == NULL ? include + include_len : include_end + 1;
+
+            if(!found)
+                continue;
+
+            // Headers are found by different paths, e.g. "foo/bar.h" and "./foo/bar.h", but listing a header twice is harmless
+            const char* normalized_filepath = header_filepath;
+            while(normalized_filepath[0] == '.' && normalized_filepath[1] == CBREW_PATH_SEPARATOR)
+                normalized_filepath += 2;
+
+            CbrewBool already_found = CBREW_FALSE;
+            for(size_t j = 0; j < files_count && !already_found; ++j)
+                already_found = strcmp(files[j], normalized_filepath) == 0;
+
+            if(already_found)
+                continue;
+
+            if(files_count == files_capacity)
+            {
+                files_capacity *= 2;
+                files = realloc(files, files_capacity * sizeof(char*));
+            }
+
+            files[files_count++] = strdup(normalized_filepath);
+        }
+    }
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    for(size_t i = 0; i < files_count; ++i)
+    {
+        cbrew_string_builder_append_format(&sb, i == 0 ? "%s" : " %s", files[i]);
+        free(files[i]);
+    }
+
+    free(files);
+
+    return cbrew_string_builder_release(&sb);
+}
+
+size_t cbrew_project_config_update_manifest(const CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, CbrewCleanMode clean_mode)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(clean_mode < CBREW_CLEAN_MODE_SIZE);
+
+    // The tests of other shards aren't part of the graph, but they aren't stale either
+    if(project->type == CBREW_PROJECT_TYPE_TEST && handler.shard_count > 0 && clean_mode == CBREW_CLEAN_MODE_STALE)
+        clean_mode = CBREW_CLEAN_MODE_NONE;
+
+    // Every compile action creates an object file, a dependency file and maybe a split debug information file, every share action shares the first two,
+    // every step creates its outputs, and every other action creates a product and maybe a test stamp or benchmark results
+    size_t outputs_capacity = 3 * graph->actions_count + 1;
+    for(size_t i = 0; i < project->steps_count; ++i)
+        outputs_capacity += project->steps[i]->outputs_count;
+
+    size_t outputs_count = 0;
+    char** outputs = malloc(outputs_capacity * sizeof(char*));
+
+    // Steps run once for all configs of their project, so their outputs belong to the first config, even if a build selects only other configs
+    const CbrewBool owns_step_outputs = config == project->configs[0];
+
+    for(size_t i = 0; i < project->steps_count && owns_step_outputs; ++i)
+    {
+        for(size_t j = 0; j < project->steps[i]->outputs_count; ++j)
+            outputs[outputs_count++] = strdup(project->steps[i]->outputs[j]);
+    }
+
+    for(size_t i = 0; i < graph->actions_count; ++i)
+    {
+        const CbrewAction* action = &graph->actions[i];
+
+        // Tests and benchmarks aren't run by every build, so their stamps and results are recorded together with their executables instead
+        if(action->project != project || action->config != config || action->type == CBREW_ACTION_TYPE_TEST || action->type == CBREW_ACTION_TYPE_BENCHMARK || action->type == CBREW_ACTION_TYPE_STEP)
+            continue;
+
+        char filepath[CBREW_FILEPATH_MAX];
+        cbrew_action_output_filepath(filepath, action);
+        outputs[outputs_count++] = strdup(filepath);
+
+        if(action->type == CBREW_ACTION_TYPE_LINK && action->input != NULL)
+        {
+            if(project->type == CBREW_PROJECT_TYPE_BENCHMARK)
+                cbrew_config_benchmark_results_filepath(filepath, config, action->input);
+            else
+                cbrew_config_test_stamp_filepath(filepath, config, action->input);
+
+            outputs[outputs_count++] = strdup(filepath);
+        }
+
+        if(action->type == CBREW_ACTION_TYPE_COMPILE)
+        {
+            cbrew_config_dep_filepath(filepath, config, action->input);
+            outputs[outputs_count++] = strdup(filepath);
+
+            if(action->split_dwarf)
+            {
+                cbrew_config_dwo_filepath(filepath, config, action->input);
+                outputs[outputs_count++] = strdup(filepath);
+            }
+        }
+        else if(action->type == CBREW_ACTION_TYPE_SHARE)
+        {
+            // The shared dependency file is named like the shared object file
+            filepath[strlen(filepath) - 1] = 'd';
+            outputs[outputs_count++] = strdup(filepath);
+        }
+    }
+
+    qsort(outputs, outputs_count, sizeof(char*), cbrew_str_compare);
+
+    char manifest_filepath[CBREW_FILEPATH_MAX];
+    cbrew_config_manifest_filepath(manifest_filepath, config);
+
+    char* manifest = cbrew_file_read(manifest_filepath, NULL);
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    size_t deleted_count = 0;
+
+    for(char* line = manifest != NULL ? strtok(manifest, "\r\n") : NULL; line != NULL; line = strtok(NULL, "\r\n"))
+    {
+        if(bsearch(&line, outputs, outputs_count, sizeof(char*), cbrew_str_compare) != NULL)
+            continue;
+
+        // Step outputs recorded by another config before they were owned by the first config are still created, so they are only forgotten
+        if(cbrew_project_file_is_step_output(project, line))
+            continue;
+
+        // Stale files stay inside the manifest until they are deleted
+        if(clean_mode == CBREW_CLEAN_MODE_NONE)
+        {
+            cbrew_string_builder_append_format(&sb, "%s\n", line);
+            continue;
+        }
+
+        if(!cbrew_file_exists(line))
+            continue;
+
+        if(cbrew_get_dry_run())
+            CBREW_LOG_TRACE("Would delete stale file %s", line);
+        else if(cbrew_file_delete(line))
+            CBREW_LOG_TRACE("Deleted stale file %s", line);
+        else
+        {
+            CBREW_LOG_WARN("Failed to delete stale file %s!", line);
+            cbrew_string_builder_append_format(&sb, "%s\n", line);
+            continue;
+        }
+
+        ++deleted_count;
+    }
+
+    free(manifest);
+
+    for(size_t i = 0; i < outputs_count; ++i)
+    {
+        if(clean_mode != CBREW_CLEAN_MODE_ALL)
+            cbrew_string_builder_append_format(&sb, "%s\n", outputs[i]);
+        else if(cbrew_file_exists(outputs[i]))
+        {
+            if(cbrew_get_dry_run())
+                CBREW_LOG_TRACE("Would delete %s", outputs[i]);
+            else if(cbrew_file_delete(outputs[i]))
+                CBREW_LOG_TRACE("Deleted %s", outputs[i]);
+            else
+            {
+                CBREW_LOG_WARN("Failed to delete %s!", outputs[i]);
+                free(outputs[i]);
+                continue;
+            }
+
+            ++deleted_count;
+        }
+
+        free(outputs[i]);
+    }
+
+    free(outputs);
+
+    char* new_manifest = cbrew_string_builder_release(&sb);
+
+    if(!cbrew_get_dry_run())
+    {
+        if(clean_mode == CBREW_CLEAN_MODE_ALL)
+            cbrew_file_delete(manifest_filepath);
+        else if(cbrew_dir_exists(config->obj_dir))
+        {
+            FILE* f = fopen(manifest_filepath, "w");
+            if(f != NULL)
+            {
+                fputs(new_manifest, f);
+                fclose(f);
+            }
+            else
+                CBREW_LOG_WARN("Failed to write the manifest %s!", manifest_filepath);
+        }
+    }
+
+    free(new_manifest);
+
+    return deleted_count;
+}
+
+CbrewBool cbrew_project_config_compile(const CbrewProject* project, const CbrewConfig* config, char** project_files, size_t project_files_count)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(project_files != NULL);
+
+    if(!cbrew_dir_exists(config->obj_dir))
+        cbrew_dir_create(config->obj_dir);
+
+    CbrewGraph graph;
+    memset(&graph, 0, sizeof(CbrewGraph));
+
+    for(size_t i = 0; i < project_files_count; ++i)
+    {
+        CBREW_ASSERT(project_files[i] != NULL);
+
+        cbrew_graph_add_action(&graph, CBREW_ACTION_TYPE_COMPILE, project, config, project_files[i]);
+    }
+
+    CbrewBool result = cbrew_graph_run(&graph);
+
+    cbrew_graph_free(&graph);
+
+    return result;
+}
+
+CbrewBool cbrew_project_config_compile_static_lib(const CbrewProject* project, const CbrewConfig* config)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+
+    if(!cbrew_dir_exists(config->target_dir))
+        cbrew_dir_create(config->target_dir);
+
+    return cbrew_action_run(CBREW_ACTION_TYPE_STATIC_LIB, project, config, NULL);
+}
+
+CbrewBool cbrew_project_config_compile_dynamic_lib(const CbrewProject* project, const CbrewConfig* config)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+
+    if(!cbrew_dir_exists(config->target_dir))
+        cbrew_dir_create(config->target_dir);
+
+    return cbrew_action_run(CBREW_ACTION_TYPE_DYNAMIC_LIB, project, config, NULL);
+}
+
+CbrewBool cbrew_project_config_link(const CbrewProject* project, const CbrewConfig* config)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+
+    if(!cbrew_dir_exists(config->target_dir))
+        cbrew_dir_create(config->target_dir);
+
+    return cbrew_action_run(CBREW_ACTION_TYPE_LINK, project, config, NULL);
+}
+
+/* Build steps */
+
+CbrewStep* cbrew_project_add_step(CbrewProject* project, const char* name, const char* command)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(name != NULL);
+    CBREW_ASSERT(command != NULL);
+
+    CbrewStep* step = cbrew_arena_alloc(&handler.arena, sizeof(CbrewStep));
+
+    step->name = cbrew_intern(name);
+    step->command = cbrew_intern(command);
+
+    project->steps = cbrew_arena_array_grow(&handler.arena, project->steps, project->steps_count, &project->steps_capacity, sizeof(CbrewStep*));
+    project->steps[project->steps_count++] = step;
+
+    return step;
+}
+
+void cbrew_step_add_input(CbrewStep* step, const char* wildcard)
+{
+    CBREW_ASSERT(step != NULL);
+    CBREW_ASSERT(wildcard != NULL);
+
+    char source_path[CBREW_FILEPATH_MAX];
+    cbrew_source_path(source_path, wildcard);
+
+    step->inputs = cbrew_arena_array_grow(&handler.arena, step->inputs, step->inputs_count, &step->inputs_capacity, sizeof(char*));
+    step->inputs[step->inputs_count++] = cbrew_intern(source_path);
+}
+
+void cbrew_step_add_output(CbrewStep* step, const char* filepath)
+{
+    CBREW_ASSERT(step != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    char source_path[CBREW_FILEPATH_MAX];
+    cbrew_source_path(source_path, filepath);
+
+    step->outputs = cbrew_arena_array_grow(&handler.arena, step->outputs, step->outputs_count, &step->outputs_capacity, sizeof(char*));
+    step->outputs[step->outputs_count++] = cbrew_intern(source_path);
+}
+
+void cbrew_source_path(char* source_path, const char* path)
+{
+    CBREW_ASSERT(source_path != NULL);
+    CBREW_ASSERT(path != NULL);
+
+    const CbrewBool absolute = path[0] == '/' || path[0] == '\\' || (isalpha((unsigned char) path[0]) && path[1] == ':');
+
+    if(absolute || path[0] == '.')
+        strcpy(source_path, path);
+    else
+        sprintf(source_path, ".%c%s", CBREW_PATH_SEPARATOR, path);
+
+    cbrew_path(source_path);
+}
+
+void cbrew_normalized_path(char* normalized_path, const char* path)
+{
+    CBREW_ASSERT(normalized_path != NULL);
+    CBREW_ASSERT(path != NULL);
+
+    char source_path[CBREW_FILEPATH_MAX];
+    cbrew_source_path(source_path, path);
+
+    // The leading "." or root is kept, every following component is only copied if it names a directory or file
+    size_t len = 0;
+
+    for(const char* c = source_path; *c != '\0'; )
+    {
+        const size_t component_len = strcspn(c, "/\\");
+
+        const CbrewBool skipped = c != source_path && (component_len == 0 || (component_len == 1 && c[0] == '.'));
+
+        if(!skipped)
+        {
+            if(c != source_path)
+                normalized_path[len++] = CBREW_PATH_SEPARATOR;
+
+            memcpy(normalized_path + len, c, component_len);
+            len += component_len;
+        }
+
+        c += component_len;
+
+        if(*c != '\0')
+            ++c;
+    }
+
+    normalized_path[len] = '\0';
+}
+
+size_t cbrew_graph_add_step_action(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, const CbrewStep* step)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(step != NULL);
+    CBREW_ASSERT(step->outputs_count > 0);
+
+    const size_t step_action = cbrew_graph_add_action(graph, CBREW_ACTION_TYPE_STEP, project, config, NULL);
+
+    graph->actions[step_action].step = step;
+
+    for(size_t i = 0; i < step->outputs_count && !cbrew_get_dry_run() && cbrew_get_clean_mode() == CBREW_CLEAN_MODE_NONE; ++i)
+    {
+        char dir[CBREW_FILEPATH_MAX];
+        strcpy(dir, step->outputs[i]);
+
+        char* last_path_separator = strrchr(dir, CBREW_PATH_SEPARATOR);
+        if(last_path_separator == NULL)
+            continue;
+
+        *last_path_separator = '\0';
+
+        if(!cbrew_dir_exists(dir))
+            cbrew_dir_create(dir);
+    }
+
+    return step_action;
+}
+
+/* Configs */
+
+CbrewConfig* cbrew_project_config_create(CbrewProject* project, const char* name, const char* target_dir, const char* obj_dir)
+{
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(name != NULL);
+    CBREW_ASSERT(target_dir != NULL);
+    CBREW_ASSERT(obj_dir != NULL);
+
+    name = cbrew_intern(name);
+
+    for(size_t i = 0; i < project->configs_count; ++i)
+    {
+        if(project->configs[i]->name == name)
+        {
+            CBREW_LOG_WARN("Config with name %s%s%s already exists for project %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, name, CBREW_CONSOLE_COLOR_WARN, CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+            return project->configs[i];
+        }
+    }
+
+    CbrewConfig* config = cbrew_arena_alloc(&handler.arena, sizeof(CbrewConfig));
+
+    config->name = name;
+    config->target_dir = cbrew_intern_path(target_dir);
+    config->obj_dir = cbrew_intern_path(obj_dir);
+
+    project->configs = cbrew_arena_array_grow(&handler.arena, project->configs, project->configs_count, &project->configs_capacity, sizeof(CbrewConfig*));
+    project->configs[project->configs_count++] = config;
+
+    return config;
+}
+
+void cbrew_config_add_flag(CbrewConfig* config, const char* flag)
+{
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(flag != NULL);
+
+    config->flags = cbrew_arena_array_grow(&handler.arena, config->flags, config->flags_count, &config->flags_capacity, sizeof(char*));
+    config->flags[config->flags_count++] = cbrew_intern(flag);
+}
+
+void cbrew_config_add_define(CbrewConfig* config, const char* define)
+{
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(define != NULL);
+
+    config->defines = cbrew_arena_array_grow(&handler.arena, config->defines, config->defines_count, &config->defines_capacity, sizeof(char*));
+    config->defines[config->defines_count++] = cbrew_intern(define);
+}
+
+void cbrew_config_set_install_dir(CbrewConfig* config, const char* install_dir)
+{
+    CBREW_ASSERT(config != NULL);
+
+    config->install_dir = install_dir == NULL ? NULL : cbrew_intern_path(install_dir);
+}
+
+void cbrew_config_set_thin_archive(CbrewConfig* config, CbrewBool thin_archive)
+{
+    CBREW_ASSERT(config != NULL);
+
+    config->thin_archive = thin_archive;
+}
+
+void cbrew_config_set_toolchain(CbrewConfig* config, CbrewToolchain* toolchain)
+{
+    CBREW_ASSERT(config != NULL);
+
+    config->toolchain = toolchain;
+}
+
+void cbrew_config_set_fast_link(CbrewConfig* config, CbrewBool fast_link)
+{
+    CBREW_ASSERT(config != NULL);
+
+    config->fast_link = fast_link;
+}
+
+void cbrew_config_set_compress_debug_sections(CbrewConfig* config, CbrewBool compress_debug_sections)
+{
+    CBREW_ASSERT(config != NULL);
+
+    config->compress_debug_sections = compress_debug_sections;
+}
+
+CbrewToolchain* cbrew_config_toolchain(const CbrewConfig* config)
+{
+    CBREW_ASSERT(config != NULL);
+
+    if(handler.toolchain_name != NULL)
+    {
+        CbrewToolchain* toolchain = cbrew_toolchain_find(handler.toolchain_name);
+        if(toolchain != NULL)
+            return toolchain;
+    }
+
+    return config->toolchain != NULL ? config->toolchain : cbrew_toolchain_default();
+}
+
+void cbrew_config_obj_filepath(char* obj_filepath, const CbrewConfig* config, const char* filepath)
+{
+    CBREW_ASSERT(obj_filepath != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    const char* filename = strrchr(filepath, CBREW_PATH_SEPARATOR);
+    filename = filename == NULL ? filepath : filename + 1;
+
+    sprintf(obj_filepath, "%s%c%s", config->obj_dir, CBREW_PATH_SEPARATOR, filename);
+
+    char* extension = strrchr(obj_filepath, '.');
+    if(extension != NULL && strchr(extension, CBREW_PATH_SEPARATOR) == NULL)
+    {
+        extension[1] = 'o';
+        extension[2] = '\0';
+    }
+    else
+        strcat(obj_filepath, ".o");
+}
+
+void cbrew_config_dep_filepath(char* dep_filepath, const CbrewConfig* config, const char* filepath)
+{
+    CBREW_ASSERT(dep_filepath != NULL);
+
+    cbrew_config_obj_filepath(dep_filepath, config, filepath);
+
+    dep_filepath[strlen(dep_filepath) - 1] = 'd';
+}
+
+void cbrew_config_test_filepath(char* test_filepath, const CbrewConfig* config, const char* filepath)
+{
+    CBREW_ASSERT(test_filepath != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    const char* filename = strrchr(filepath, CBREW_PATH_SEPARATOR);
+    filename = filename == NULL ? filepath : filename + 1;
+
+    const char* extension = strrchr(filename, '.');
+    const int filename_len = extension == NULL ? (int) strlen(filename) : (int) (extension - filename);
+
+    sprintf(test_filepath, "%s%c%.*s", config->target_dir, CBREW_PATH_SEPARATOR, filename_len, filename);
+}
+
+void cbrew_config_test_stamp_filepath(char* stamp_filepath, const CbrewConfig* config, const char* filepath)
+{
+    CBREW_ASSERT(stamp_filepath != NULL);
+
+    cbrew_config_obj_filepath(stamp_filepath, config, filepath);
+
+    strcpy(stamp_filepath + strlen(stamp_filepath) - 1, "passed");
+}
+
+void cbrew_config_benchmark_results_filepath(char* results_filepath, const CbrewConfig* config, const char* filepath)
+{
+    CBREW_ASSERT(results_filepath != NULL);
+
+    cbrew_config_obj_filepath(results_filepath, config, filepath);
+
+    strcpy(results_filepath + strlen(results_filepath) - 1, "bench");
+}
+
+void cbrew_config_dwo_filepath(char* dwo_filepath, const CbrewConfig* config, const char* filepath)
+{
+    CBREW_ASSERT(dwo_filepath != NULL);
+
+    cbrew_config_obj_filepath(dwo_filepath, config, filepath);
+
+    strcpy(dwo_filepath + strlen(dwo_filepath) - 1, "dwo");
+}
+
+void cbrew_config_manifest_filepath(char* manifest_filepath, const CbrewConfig* config)
+{
+    CBREW_ASSERT(manifest_filepath != NULL);
+    CBREW_ASSERT(config != NULL);
+
+    // Object files always end with .o, so they can't be named like the manifest
+    sprintf(manifest_filepath, "%s%cmanifest", config->obj_dir, CBREW_PATH_SEPARATOR);
+}
+
+char* cbrew_config_create_obj_files_str(const CbrewConfig* config)
+{
+    CBREW_ASSERT(config != NULL);
+
+    char obj_file_wildcard[CBREW_FILEPATH_MAX];
+    sprintf(obj_file_wildcard, "%s%c*.o", config->obj_dir, CBREW_PATH_SEPARATOR);
+
+    size_t obj_files_count = 0;
+    char** obj_files = cbrew_find_files(config->obj_dir, &obj_files_count);
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    for(size_t i = 0; i < obj_files_count; ++i)
+    {
+        if(cbrew_file_matches_wildcard(obj_files[i], obj_file_wildcard))
+            cbrew_string_builder_append_format(&sb, sb.len == 0 ? "\"%s\"" : " \"%s\"", obj_files[i]);
+
+        free(obj_files[i]);
+    }
+
+    free(obj_files);
+
+    if(sb.len == 0)
+        CBREW_LOG_WARN("Config %s%s%s has no object files!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_WARN);
+
+    return cbrew_string_builder_release(&sb);
+}
+
+/* Toolchains */
+
+CbrewToolchain* cbrew_toolchain_create(const char* name, const char* compiler)
+{
+    CBREW_ASSERT(name != NULL);
+    CBREW_ASSERT(compiler != NULL);
+
+    name = cbrew_intern(name);
+
+    for(size_t i = 0; i < handler.toolchains_count; ++i)
+    {
+        if(handler.toolchains[i]->name == name)
+        {
+            CBREW_LOG_WARN("Toolchain with name %s already exists!", name);
+            return handler.toolchains[i];
+        }
+    }
+
+    CbrewToolchain* toolchain = cbrew_arena_alloc(&handler.arena, sizeof(CbrewToolchain));
+
+    toolchain->name = name;
+    toolchain->compiler = cbrew_intern(compiler);
+    toolchain->archiver = cbrew_intern("ar");
+
+    handler.toolchains = cbrew_arena_array_grow(&handler.arena, handler.toolchains, handler.toolchains_count, &handler.toolchains_capacity, sizeof(CbrewToolchain*));
+    handler.toolchains[handler.toolchains_count++] = toolchain;
+
+    return toolchain;
+}
+
+CbrewToolchain* cbrew_toolchain_default(void)
+{
+    if(handler.default_toolchain != NULL)
+        return handler.default_toolchain;
+
+    const char* compiler = getenv("CBREW_CC");
+    CbrewToolchain* toolchain = cbrew_toolchain_create("default", compiler != NULL && *compiler != '\0' ? compiler : CBREW_COMPILER);
+
+    const char* archiver = getenv("CBREW_AR");
+    if(archiver != NULL && *archiver != '\0')
+        cbrew_toolchain_set_archiver(toolchain, archiver);
+
+    const char* launcher = getenv("CBREW_LAUNCHER");
+    if(launcher != NULL && *launcher != '\0')
+        cbrew_toolchain_set_launcher(toolchain, launcher);
+
+    handler.default_toolchain = toolchain;
+
+    return toolchain;
+}
+
+CbrewToolchain* cbrew_toolchain_find(const char* name)
+{
+    CBREW_ASSERT(name != NULL);
+
+    // The default toolchain is only created on demand, but can be selected by its name anyway
+    if(strcmp(name, "default") == 0)
+        return cbrew_toolchain_default();
+
+    for(size_t i = 0; i < handler.toolchains_count; ++i)
+    {
+        if(strcmp(handler.toolchains[i]->name, name) == 0)
+            return handler.toolchains[i];
+    }
+
+    return NULL;
+}
+
+void cbrew_toolchain_set_archiver(CbrewToolchain* toolchain, const char* archiver)
+{
+    CBREW_ASSERT(toolchain != NULL);
+    CBREW_ASSERT(archiver != NULL);
+
+    toolchain->archiver = cbrew_intern(archiver);
+}
+
+void cbrew_toolchain_set_linker(CbrewToolchain* toolchain, const char* linker)
+{
+    CBREW_ASSERT(toolchain != NULL);
+
+    toolchain->linker = linker == NULL ? NULL : cbrew_intern(linker);
+}
+
+void cbrew_toolchain_set_launcher(CbrewToolchain* toolchain, const char* launcher)
+{
+    CBREW_ASSERT(toolchain != NULL);
+
+    toolchain->launcher = launcher == NULL ? NULL : cbrew_intern(launcher);
+}
+
+void cbrew_toolchain_probe(CbrewToolchain* toolchain)
+{
+    CBREW_ASSERT(toolchain != NULL);
+
+    if(toolchain->probed)
+        return;
+
+    toolchain->probed = CBREW_TRUE;
+
+    // The cached capabilities are only valid for the same compiler executable, so updating the compiler probes it again
+    char compiler_program[CBREW_FILEPATH_MAX];
+    cbrew_compiler_program(compiler_program, toolchain->compiler);
+
+    char compiler_filepath[CBREW_FILEPATH_MAX];
+    const uint64_t compiler_mtime = cbrew_program_filepath(compiler_filepath, compiler_program) ? cbrew_file_mtime(compiler_filepath) : 0;
+
+    static const struct
+    {
+        CbrewToolchainCapabilities capability;
+        const char* flags;
+    } probes[] =
+    {
+        { CBREW_TOOLCHAIN_CAPABILITY_DEPFILES, "-MMD -MF \".cbrew" CBREW_PATH_SEPARATOR_STR "probe0.d\" -c" },
+        { CBREW_TOOLCHAIN_CAPABILITY_LLD, "-fuse-ld=lld" },
+        { CBREW_TOOLCHAIN_CAPABILITY_MOLD, "-fuse-ld=mold" },
+        { CBREW_TOOLCHAIN_CAPABILITY_GOLD, "-fuse-ld=gold" },
+        { CBREW_TOOLCHAIN_CAPABILITY_SPLIT_DWARF, "-g -gsplit-dwarf -c" },
+        { CBREW_TOOLCHAIN_CAPABILITY_LTO, "-flto" },
+        { CBREW_TOOLCHAIN_CAPABILITY_COMPRESS_DEBUG_SECTIONS, "-g -Wl,--compress-debug-sections=zlib" }
+    };
+
+    const size_t probes_count = sizeof(probes) / sizeof(probes[0]);
+
+    // Cached results that lack a newer probe are incomplete, so they are probed again
+    CbrewToolchainCapabilities probed_capabilities = 0;
+    for(size_t i = 0; i < probes_count; ++i)
+        probed_capabilities |= probes[i].capability;
+
+    char* cache = cbrew_file_read(CBREW_TOOLCHAIN_CACHE_FILEPATH, NULL);
+    CbrewBool cached = CBREW_FALSE;
+
+    for(char* line = cache; line != NULL && *line != '\0' && !cached; )
+    {
+        char* line_end = strchr(line, '\n');
+        if(line_end != NULL)
+            *line_end = '\0';
+
+        unsigned int probed = 0;
+        unsigned int capabilities = 0;
+        unsigned long long mtime = 0;
+        int compiler_offset = 0;
+
+        if(sscanf(line, "%x %x %llu %n", &probed, &capabilities, &mtime, &compiler_offset) == 3 && compiler_offset > 0 && strcmp(line + compiler_offset, toolchain->compiler) == 0 && probed == probed_capabilities && mtime == compiler_mtime && mtime != 0)
+        {
+            toolchain->capabilities = capabilities;
+            cached = CBREW_TRUE;
+        }
+
+        line = line_end == NULL ? NULL : line_end + 1;
+    }
+
+    free(cache);
+
+    if(!cached && (cbrew_get_dry_run() || cbrew_get_clean_mode() != CBREW_CLEAN_MODE_NONE))
+    {
+        CBREW_LOG_TRACE("Toolchain %s hasn't been probed yet, so only its default features are used", toolchain->name);
+
+        toolchain->capabilities = CBREW_TOOLCHAIN_CAPABILITY_DEPFILES;
+        cached = CBREW_TRUE;
+    }
+
+    if(!cached)
+    {
+        const char* probe_source = ".cbrew" CBREW_PATH_SEPARATOR_STR "probe.c";
+
+        FILE* f = cbrew_dir_exists(".cbrew") || cbrew_dir_create(".cbrew") ? fopen(probe_source, "w") : NULL;
+        if(f != NULL)
+        {
+            fputs("int main(void)\n{\n    return 0;\n}\n", f);
+            fclose(f);
+        }
+        else
+        {
+            // Every supported compiler writes dependency files, so only the optional features are unavailable
+            CBREW_LOG_WARN("Failed to probe toolchain %s!", toolchain->name);
+            toolchain->capabilities = CBREW_TOOLCHAIN_CAPABILITY_DEPFILES;
+        }
+
+        // Every probe is a separate compiler process, so all of them are run at once
+        CbrewProcess processes[sizeof(probes) / sizeof(probes[0])];
+        size_t process_probes[sizeof(probes) / sizeof(probes[0])];
+        size_t running_count = 0;
+
+        for(size_t i = 0; i < probes_count && f != NULL; ++i)
+        {
+            char* cmd = cbrew_create_str("%s %s \"%s\" -o \".cbrew%cprobe%zu.out\"", toolchain->compiler, probes[i].flags, probe_source, CBREW_PATH_SEPARATOR, i);
+
+            if(cbrew_process_start(&processes[running_count], cmd, CBREW_TRUE, CBREW_FALSE))
+                process_probes[running_count++] = i;
+
+            free(cmd);
+        }
+
+        while(running_count > 0)
+        {
+            size_t finished = 0;
+            CbrewBool success = CBREW_FALSE;
+
+            if(!cbrew_process_wait_any(processes, running_count, -1, &finished, &success, NULL))
+            {
+                for(size_t i = 0; i < running_count; ++i)
+                    cbrew_string_builder_free(&processes[i].output);
+
+                break;
+            }
+
+            cbrew_string_builder_free(&processes[finished].output);
+
+            if(success)
+                toolchain->capabilities |= probes[process_probes[finished]].capability;
+
+            --running_count;
+            processes[finished] = processes[running_count];
+            process_probes[finished] = process_probes[running_count];
+        }
+
+        cbrew_file_delete(probe_source);
+
+        for(size_t i = 0; i < probes_count; ++i)
+        {
+            char probe_filepath[CBREW_FILEPATH_MAX];
+
+            sprintf(probe_filepath, ".cbrew%cprobe%zu.out", CBREW_PATH_SEPARATOR, i);
+            cbrew_file_delete(probe_filepath);
+
+            sprintf(probe_filepath, ".cbrew%cprobe%zu.d", CBREW_PATH_SEPARATOR, i);
+            cbrew_file_delete(probe_filepath);
+
+            sprintf(probe_filepath, ".cbrew%cprobe%zu.dwo", CBREW_PATH_SEPARATOR, i);
+            cbrew_file_delete(probe_filepath);
+        }
+
+        if(compiler_mtime != 0 && f != NULL)
+        {
+            cache = cbrew_file_read(CBREW_TOOLCHAIN_CACHE_FILEPATH, NULL);
+
+            f = fopen(CBREW_TOOLCHAIN_CACHE_FILEPATH, "w");
+            if(f != NULL)
+            {
+                // Entries of other compilers are kept, so switching between toolchains doesn't probe them again
+                for(char* line = cache; line != NULL && *line != '\0'; )
+                {
+                    char* line_end = strchr(line, '\n');
+                    if(line_end != NULL)
+                        *line_end = '\0';
+
+                    unsigned int probed = 0;
+                    unsigned int capabilities = 0;
+                    unsigned long long mtime = 0;
+                    int compiler_offset = 0;
+                    sscanf(line, "%x %x %llu %n", &probed, &capabilities, &mtime, &compiler_offset);
+
+                    if(compiler_offset > 0 && strcmp(line + compiler_offset, toolchain->compiler) != 0)
+                        fprintf(f, "%s\n", line);
+
+                    line = line_end == NULL ? NULL : line_end + 1;
+                }
+
+                fprintf(f, "%x %x %llu %s\n", (unsigned int) probed_capabilities, (unsigned int) toolchain->capabilities, (unsigned long long) compiler_mtime, toolchain->compiler);
+                fclose(f);
+            }
+
+            free(cache);
+        }
+    }
+
+    // Linkers that are known to be missing would fail every link, so the default linker is used instead
+    if(toolchain->linker != NULL)
+    {
+        CbrewToolchainCapabilities linker_capability = 0;
+
+        if(strcmp(toolchain->linker, "lld") == 0)
+            linker_capability = CBREW_TOOLCHAIN_CAPABILITY_LLD;
+        else if(strcmp(toolchain->linker, "mold") == 0)
+            linker_capability = CBREW_TOOLCHAIN_CAPABILITY_MOLD;
+        else if(strcmp(toolchain->linker, "gold") == 0)
+            linker_capability = CBREW_TOOLCHAIN_CAPABILITY_GOLD;
+
+        if(linker_capability != 0 && (toolchain->capabilities & linker_capability) == 0)
+        {
+            CBREW_LOG_WARN("Toolchain %s can't use the linker %s, using the default linker instead!", toolchain->name, toolchain->linker);
+            toolchain->linker = NULL;
+        }
+    }
+}
+
+CbrewBool cbrew_toolchain_supports(CbrewToolchain* toolchain, CbrewToolchainCapabilities capabilities)
+{
+    CBREW_ASSERT(toolchain != NULL);
+
+    cbrew_toolchain_probe(toolchain);
+
+    return (toolchain->capabilities & capabilities) == capabilities;
+}
+
+/* Actions */
+
+size_t cbrew_graph_add_action(CbrewGraph* graph, CbrewActionType type, const CbrewProject* project, const CbrewConfig* config, const char* input)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(type < CBREW_ACTION_TYPE_SIZE);
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT((type != CBREW_ACTION_TYPE_COMPILE && type != CBREW_ACTION_TYPE_INSTALL && type != CBREW_ACTION_TYPE_SHARE && type != CBREW_ACTION_TYPE_TEST && type != CBREW_ACTION_TYPE_BENCHMARK) || input != NULL);
+
+    ++graph->actions_count;
+    graph->actions = realloc(graph->actions, graph->actions_count * sizeof(CbrewAction));
+
+    CbrewAction* action = &graph->actions[graph->actions_count - 1];
+
+    memset(action, 0, sizeof(CbrewAction));
+
+    action->type = type;
+    action->state = CBREW_ACTION_STATE_PENDING;
+    action->project = project;
+    action->config = config;
+    action->input = input == NULL ? NULL : strdup(input);
+
+    CbrewConfigArgs* args = cbrew_graph_config_args(graph, project, config);
+    action->args = args;
+
+    // Products are created from the object files of the current source files only, stale object files are never linked
+    if(type == CBREW_ACTION_TYPE_COMPILE)
+    {
+        // Most source files are compiled with the arguments of their config, so only files with their own flags get their own arguments,
+        // which may also add or remove debug information
+        action->split_dwarf = args->split_dwarf;
+
+        if(cbrew_project_file_has_flags(project, input))
+        {
+            action->split_dwarf = cbrew_project_config_splits_dwarf(project, config, args->toolchain, input);
+            action->compile_args = cbrew_project_config_compile_args(project, config, input, action->split_dwarf);
+        }
+
+        char obj_filepath[CBREW_FILEPATH_MAX];
+        cbrew_config_obj_filepath(obj_filepath, config, input);
+
+        cbrew_string_builder_append_format(&args->obj_files, args->obj_files.len == 0 ? "\"%s\"" : " \"%s\"", obj_filepath);
+    }
+
+    return graph->actions_count - 1;
+}
+
+size_t cbrew_graph_add_install_action(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config, const char* input, const char* destination)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(input != NULL);
+    CBREW_ASSERT(destination != NULL);
+
+    const size_t install_action = cbrew_graph_add_action(graph, CBREW_ACTION_TYPE_INSTALL, project, config, input);
+
+    graph->actions[install_action].destination = strdup(destination);
+
+    return install_action;
+}
+
+void cbrew_graph_add_dependency(CbrewGraph* graph, size_t action, size_t dependency)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(action < graph->actions_count);
+    CBREW_ASSERT(dependency < graph->actions_count);
+    CBREW_ASSERT(action != dependency);
+
+    CbrewAction* a = &graph->actions[action];
+
+    ++a->dependencies_count;
+    a->dependencies = realloc(a->dependencies, a->dependencies_count * sizeof(size_t));
+    a->dependencies[a->dependencies_count - 1] = dependency;
+}
+
+void cbrew_graph_add_link_dependencies(CbrewGraph* graph)
+{
+    CBREW_ASSERT(graph != NULL);
+
+    for(size_t i = 0; i < graph->actions_count; ++i)
+    {
+        const CbrewActionType type = graph->actions[i].type;
+
+        if(type != CBREW_ACTION_TYPE_LINK && type != CBREW_ACTION_TYPE_STATIC_LIB && type != CBREW_ACTION_TYPE_DYNAMIC_LIB)
+            continue;
+
+        const CbrewProject* project = graph->actions[i].project;
+
+        for(size_t j = 0; j < project->links_count; ++j)
+        {
+            // Libraries that aren't created by any project, e.g. system libraries, never have to wait
+            const CbrewConfig* library_config = cbrew_link_find_config(project->links[j]);
+
+            if(library_config == NULL)
+                continue;
+
+            for(size_t k = 0; k < graph->actions_count; ++k)
+            {
+                const CbrewAction* library_action = &graph->actions[k];
+
+                if(k != i && library_action->config == library_config && (library_action->type == CBREW_ACTION_TYPE_STATIC_LIB || library_action->type == CBREW_ACTION_TYPE_DYNAMIC_LIB))
+                    cbrew_graph_add_dependency(graph, i, k);
+            }
+        }
+    }
+}
+
+CbrewConfigArgs* cbrew_graph_config_args(CbrewGraph* graph, const CbrewProject* project, const CbrewConfig* config)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(config != NULL);
+
+    // Actions of the same config are usually added together, so search the most recent arguments first
+    for(size_t i = graph->config_args_count; i > 0; --i)
+    {
+        CbrewConfigArgs* args = graph->config_args[i - 1];
+
+        if(args->project == project && args->config == config)
+            return args;
+    }
+
+    CbrewConfigArgs* args = malloc(sizeof(CbrewConfigArgs));
+    memset(args, 0, sizeof(CbrewConfigArgs));
+
+    args->project = project;
+    args->config = config;
+
+    CbrewToolchain* toolchain = cbrew_config_toolchain(config);
+    cbrew_toolchain_probe(toolchain);
+    args->toolchain = toolchain;
+
+    // Fast linking prefers the fastest available linker, unless the toolchain names a linker itself
+    const char* linker = toolchain->linker;
+    if(config->fast_link && linker == NULL)
+    {
+        if(toolchain->capabilities & CBREW_TOOLCHAIN_CAPABILITY_MOLD)
+            linker = "mold";
+        else if(toolchain->capabilities & CBREW_TOOLCHAIN_CAPABILITY_LLD)
+            linker = "lld";
+        else if(toolchain->capabilities & CBREW_TOOLCHAIN_CAPABILITY_GOLD)
+            linker = "gold";
+    }
+
+    args->split_dwarf = cbrew_project_config_splits_dwarf(project, config, toolchain, NULL);
+
+    const CbrewBool compress_debug_sections = config->compress_debug_sections && (toolchain->capabilities & CBREW_TOOLCHAIN_CAPABILITY_COMPRESS_DEBUG_SECTIONS);
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    args->compile_args = cbrew_project_config_compile_args(project, config, NULL, args->split_dwarf);
+
+    cbrew_string_builder_append_include_dirs(&sb, project->include_dirs, project->include_dirs_count);
+    cbrew_string_builder_append_flags(&sb, project->flags, project->flags_count);
+    cbrew_string_builder_append_flags(&sb, config->flags, config->flags_count);
+    if(linker != NULL)
+        cbrew_string_builder_append_format(&sb, "-fuse-ld=%s ", linker);
+    if(compress_debug_sections)
+        cbrew_string_builder_append(&sb, "-Wl,--compress-debug-sections=zlib ");
+    args->link_args = cbrew_string_builder_release(&sb);
+
+    cbrew_string_builder_append_flags(&sb, project->flags, project->flags_count);
+    cbrew_string_builder_append_flags(&sb, config->flags, config->flags_count);
+    if(linker != NULL)
+        cbrew_string_builder_append_format(&sb, "-fuse-ld=%s ", linker);
+    if(compress_debug_sections)
+        cbrew_string_builder_append(&sb, "-Wl,--compress-debug-sections=zlib ");
+    args->dynamic_lib_args = cbrew_string_builder_release(&sb);
+
+    cbrew_string_builder_append_links(&sb, project->links, project->links_count);
+    args->links = cbrew_string_builder_release(&sb);
+
+    ++graph->config_args_count;
+    graph->config_args = realloc(graph->config_args, graph->config_args_count * sizeof(CbrewConfigArgs*));
+    graph->config_args[graph->config_args_count - 1] = args;
+
+    return args;
+}
+
+uint64_t cbrew_action_compile_signature(const CbrewAction* action)
+{
+    CBREW_ASSERT(action != NULL);
+    CBREW_ASSERT(action->type == CBREW_ACTION_TYPE_COMPILE);
+
+    const char* compile_args = action->compile_args != NULL ? action->compile_args : action->args->compile_args;
+
+    char* command = cbrew_create_str("%s %s\"%s\"", action->args->toolchain->compiler, compile_args, action->input);
+    const uint64_t signature = cbrew_hash_str(command);
+
+    free(command);
+
+    return signature;
+}
+
+int cbrew_action_compare_signatures(const void* a, const void* b)
+{
+    CBREW_ASSERT(a != NULL);
+    CBREW_ASSERT(b != NULL);
+
+    const CbrewAction* first = *(const CbrewAction* const*) a;
+    const CbrewAction* second = *(const CbrewAction* const*) b;
+
+    if(first->signature != second->signature)
+        return first->signature < second->signature ? -1 : 1;
+
+    return first < second ? -1 : (first > second ? 1 : 0);
+}
+
+void cbrew_graph_share_compile_actions(CbrewGraph* graph, size_t begin, size_t end)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(begin <= end && end <= graph->actions_count);
+
+    CbrewAction** compile_actions = malloc((end - begin + 1) * sizeof(CbrewAction*));
+    size_t compile_actions_count = 0;
+
+    // The signature is replaced by the signature of the whole command when the graph is run
+    for(size_t i = begin; i < end; ++i)
+    {
+        CbrewAction* action = &graph->actions[i];
+
+        if(action->type != CBREW_ACTION_TYPE_COMPILE || action->split_dwarf)
+            continue;
+
+        action->signature = cbrew_action_compile_signature(action);
+        compile_actions[compile_actions_count++] = action;
+    }
+
+    // Equal signatures end up next to each other, each group starting with the action that was added first
+    qsort(compile_actions, compile_actions_count, sizeof(CbrewAction*), cbrew_action_compare_signatures);
+
+    CbrewAction* compiling_action = NULL;
+
+    for(size_t i = 0; i < compile_actions_count; ++i)
+    {
+        CbrewAction* action = compile_actions[i];
+
+        if(compiling_action == NULL || compiling_action->signature != action->signature)
+        {
+            compiling_action = action;
+            continue;
+        }
+
+        char compiled_obj_filepath[CBREW_FILEPATH_MAX];
+        cbrew_action_output_filepath(compiled_obj_filepath, compiling_action);
+
+        char obj_filepath[CBREW_FILEPATH_MAX];
+        cbrew_action_output_filepath(obj_filepath, action);
+
+        free(action->input);
+
+        action->type = CBREW_ACTION_TYPE_SHARE;
+        action->input = strdup(compiled_obj_filepath);
+        action->destination = strdup(obj_filepath);
+
+        cbrew_graph_add_dependency(graph, action - graph->actions, compiling_action - graph->actions);
+    }
+
+    free(compile_actions);
+}
+
+size_t* cbrew_graph_topological_order(const CbrewGraph* graph)
+{
+    CBREW_ASSERT(graph != NULL);
+
+    const size_t actions_count = graph->actions_count;
+
+    size_t* order = malloc((actions_count + 1) * sizeof(size_t));
+    size_t order_count = 0;
+
+    // Depth-first search, where an action is added once all of its dependencies have been added
+    size_t* stack = malloc((actions_count + 1) * sizeof(size_t));
+    size_t* next_dependency = calloc(actions_count + 1, sizeof(size_t));
+    CbrewBool* visited = calloc(actions_count + 1, sizeof(CbrewBool));
+
+    for(size_t i = 0; i < actions_count; ++i)
+    {
+        if(visited[i])
+            continue;
+
+        size_t stack_count = 0;
+        stack[stack_count++] = i;
+        visited[i] = CBREW_TRUE;
+
+        while(stack_count > 0)
+        {
+            const size_t current = stack[stack_count - 1];
+            const CbrewAction* action = &graph->actions[current];
+
+            if(next_dependency[current] < action->dependencies_count)
+            {
+                const size_t dependency = action->dependencies[next_dependency[current]++];
+
+                if(!visited[dependency])
+                {
+                    visited[dependency] = CBREW_TRUE;
+                    stack[stack_count++] = dependency;
+                }
+
+                continue;
+            }
+
+            order[order_count++] = current;
+            --stack_count;
+        }
+    }
+
+    CBREW_ASSERT(order_count == actions_count);
+
+    free(stack);
+    free(next_dependency);
+    free(visited);
+
+    return order;
+}
+
+void cbrew_graph_ready_push(const CbrewGraph* graph, size_t* ready_actions, size_t* ready_count, size_t action)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(ready_actions != NULL);
+    CBREW_ASSERT(ready_count != NULL);
+
+    // Binary max-heap, where ties are broken by the order in which the actions were added to the graph
+    size_t index = (*ready_count)++;
+
+    while(index > 0)
+    {
+        const size_t parent = (index - 1) / 2;
+        const CbrewAction* parent_action = &graph->actions[ready_actions[parent]];
+        const CbrewAction* current_action = &graph->actions[action];
+
+        if(parent_action->critical_path > current_action->critical_path)
+            break;
+
+        if(parent_action->critical_path == current_action->critical_path && ready_actions[parent] < action)
+            break;
+
+        ready_actions[index] = ready_actions[parent];
+        index = parent;
+    }
+
+    ready_actions[index] = action;
+}
+
+size_t cbrew_graph_ready_pop(const CbrewGraph* graph, size_t* ready_actions, size_t* ready_count)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(ready_actions != NULL);
+    CBREW_ASSERT(ready_count != NULL && *ready_count > 0);
+
+    const size_t top = ready_actions[0];
+    const size_t last = ready_actions[--(*ready_count)];
+    const CbrewAction* last_action = &graph->actions[last];
+
+    size_t index = 0;
+
+    while(CBREW_TRUE)
+    {
+        size_t child = index * 2 + 1;
+
+        if(child >= *ready_count)
+            break;
+
+        const CbrewAction* child_action = &graph->actions[ready_actions[child]];
+
+        if(child + 1 < *ready_count)
+        {
+            const CbrewAction* sibling_action = &graph->actions[ready_actions[child + 1]];
+
+            if(sibling_action->critical_path > child_action->critical_path || (sibling_action->critical_path == child_action->critical_path && ready_actions[child + 1] < ready_actions[child]))
+            {
+                ++child;
+                child_action = sibling_action;
+            }
+        }
+
+        if(last_action->critical_path > child_action->critical_path || (last_action->critical_path == child_action->critical_path && last < ready_actions[child]))
+            break;
+
+        ready_actions[index] = ready_actions[child];
+        index = child;
+    }
+
+    ready_actions[index] = last;
+
+    return top;
+}
+
+CbrewBool cbrew_graph_run(CbrewGraph* graph)
+{
+    CBREW_ASSERT(graph != NULL);
+
+    const size_t actions_count = graph->actions_count;
+
+    if(actions_count == 0)
+        return CBREW_TRUE;
+
+    size_t jobs = cbrew_get_jobs();
+
+    CbrewJobserver* jobserver = &handler.jobserver;
+
+    if(!handler.jobserver_initialized)
+    {
+        if(!cbrew_jobserver_init(jobserver, jobs))
+            CBREW_LOG_WARN("The jobserver of make is unavailable, running one job at a time! Prefix the recipe running cbrew with '+' to fix this.");
+
+        handler.jobserver_initialized = CBREW_TRUE;
+    }
+
+    if(jobserver->unavailable)
+        jobs = 1;
+
+    if(!handler.history_loaded)
+    {
+        cbrew_history_load(&handler.history, CBREW_HISTORY_FILEPATH);
+        handler.history_loaded = CBREW_TRUE;
+    }
+
+    // Actions without a recorded peak memory usage are expected to behave like the average action,
+    // while actions without a recorded duration are expected to take as long as the average action of the same type
+    size_t known_memory_kb = 0;
+    size_t known_memory_count = 0;
+
+    double known_durations[CBREW_ACTION_TYPE_SIZE] = { 0 };
+    size_t known_durations_count[CBREW_ACTION_TYPE_SIZE] = { 0 };
+
+    for(size_t i = 0; i < actions_count; ++i)
+    {
+        CbrewAction* action = &graph->actions[i];
+
+        char output_filepath[CBREW_FILEPATH_MAX];
+        cbrew_action_output_filepath(output_filepath, action);
+
+        const CbrewHistoryEntry* entry = cbrew_history_get(&handler.history, output_filepath, CBREW_FALSE);
+
+        action->estimated_memory_kb = entry != NULL ? entry->peak_memory_kb : 0;
+        action->peak_memory_kb = 0;
+        action->estimated_duration = entry != NULL ? entry->duration : 0.0;
+
+        if(action->estimated_memory_kb > 0)
+        {
+            known_memory_kb += action->estimated_memory_kb;
+            ++known_memory_count;
+        }
+
+        if(action->estimated_duration > 0.0)
+        {
+            known_durations[action->type] += action->estimated_duration;
+            ++known_durations_count[action->type];
+        }
+    }
+
+    for(size_t i = 0; i < actions_count; ++i)
+    {
+        CbrewAction* action = &graph->actions[i];
+
+        if(action->estimated_memory_kb == 0 && known_memory_count > 0)
+            action->estimated_memory_kb = known_memory_kb / known_memory_count;
+
+        // Without any history, the critical path is the number of actions on it
+        if(action->estimated_duration <= 0.0)
+            action->estimated_duration = known_durations_count[action->type] > 0 ? known_durations[action->type] / known_durations_count[action->type] : 1.0;
+
+        action->critical_path = 0.0;
+    }
+
+    // Dependents come after their dependencies, so walking backwards completes the critical path of every dependent first
+    size_t* order = cbrew_graph_topological_order(graph);
+
+    for(size_t i = actions_count; i > 0; --i)
+    {
+        CbrewAction* action = &graph->actions[order[i - 1]];
+
+        action->critical_path += action->estimated_duration;
+
+        for(size_t j = 0; j < action->dependencies_count; ++j)
+        {
+            CbrewAction* dependency = &graph->actions[action->dependencies[j]];
+
+            if(dependency->critical_path < action->critical_path)
+                dependency->critical_path = action->critical_path;
+        }
+    }
+
+    free(order);
+
+    size_t memory_limit_kb = cbrew_get_memory_limit() * 1024;
+    if(memory_limit_kb == 0)
+        memory_limit_kb = cbrew_available_memory_kb();
+
+    const double load_limit = cbrew_get_load_limit();
+
+    // The dependents of every action are stored contiguously, starting at dependents_offsets[i]
+    size_t* dependents_offsets = calloc(actions_count + 1, sizeof(size_t));
+    size_t* pending_dependencies = calloc(actions_count, sizeof(size_t));
+
+    for(size_t i = 0; i < actions_count; ++i)
+    {
+        const CbrewAction* action = &graph->actions[i];
+
+        for(size_t j = 0; j < action->dependencies_count; ++j)
+            ++dependents_offsets[action->dependencies[j] + 1];
+
+        pending_dependencies[i] = action->dependencies_count;
+    }
+
+    for(size_t i = 0; i < actions_count; ++i)
+        dependents_offsets[i + 1] += dependents_offsets[i];
+
+    size_t* dependents = malloc((dependents_offsets[actions_count] + 1) * sizeof(size_t));
+    size_t* dependents_filled = calloc(actions_count, sizeof(size_t));
+
+    for(size_t i = 0; i < actions_count; ++i)
+    {
+        const CbrewAction* action = &graph->actions[i];
+
+        for(size_t j = 0; j < action->dependencies_count; ++j)
+        {
+            const size_t dependency = action->dependencies[j];
+            dependents[dependents_offsets[dependency] + dependents_filled[dependency]++] = i;
+        }
+    }
+
+    free(dependents_filled);
+
+    // Every action is pushed at most once, so the queue never needs to grow
+    size_t* ready_actions = malloc(actions_count * sizeof(size_t));
+    size_t ready_count = 0;
+
+    size_t* deferred_actions = malloc(actions_count * sizeof(size_t));
+
+    for(size_t i = 0; i < actions_count; ++i)
+    {
+        graph->actions[i].state = CBREW_ACTION_STATE_PENDING;
+
+        free(graph->actions[i].output);
+        graph->actions[i].output = NULL;
+
+        if(pending_dependencies[i] == 0)
+            cbrew_graph_ready_push(graph, ready_actions, &ready_count, i);
+    }
+
+    CbrewProcess* processes = malloc(jobs * sizeof(CbrewProcess));
+    size_t* running_actions = malloc(jobs * sizeof(size_t));
+    size_t running_count = 0;
+    size_t running_memory_kb = 0;
+    size_t started_count = 0;
+
+    CbrewBool result = CBREW_TRUE;
+
+    while(CBREW_TRUE)
+    {
+        CbrewBool waiting_for_token = CBREW_FALSE;
+
+        // Measured once per round, since reading it is too slow to do for every ready action
+        size_t available_memory_kb = 0;
+        CbrewBool overloaded = CBREW_FALSE;
+
+        if(running_count > 0 && ready_count > 0)
+        {
+            available_memory_kb = cbrew_available_memory_kb();
+            overloaded = load_limit > 0.0 && cbrew_load_average() >= load_limit;
+        }
+
+        while(running_count < jobs && ready_count > 0)
+        {
+            // Skipped actions stay inside the queue until they reach its front
+            if(graph->actions[ready_actions[0]].state != CBREW_ACTION_STATE_PENDING)
+            {
+                cbrew_graph_ready_pop(graph, ready_actions, &ready_count);
+                continue;
+            }
+
+            // A single action is always started, otherwise the build could never finish
+            if(running_count > 0 && overloaded)
+                break;
+
+            // The first running job uses the implicit token that every jobserver client owns
+            if(jobserver->active && running_count > jobserver->tokens_count && !cbrew_jobserver_acquire(jobserver, 0))
+            {
+                waiting_for_token = CBREW_TRUE;
+                break;
+            }
+
+            // Actions that would exceed the memory limit wait, while smaller ones with a shorter critical path may start
+            CbrewAction* action = NULL;
+            size_t deferred_count = 0;
+
+            while(action == NULL && ready_count > 0)
+            {
+                CbrewAction* candidate = &graph->actions[cbrew_graph_ready_pop(graph, ready_actions, &ready_count)];
+
+                if(candidate->state != CBREW_ACTION_STATE_PENDING)
+                    continue;
+
+                const size_t estimated_memory_kb = candidate->estimated_memory_kb;
+
+                // Benchmarks only run on their own, so other actions don't disturb their measurements
+                if(running_count > 0 && candidate->type == CBREW_ACTION_TYPE_BENCHMARK)
+                    deferred_actions[deferred_count++] = candidate - graph->actions;
+                else if(running_count > 0 && memory_limit_kb > 0 && running_memory_kb + estimated_memory_kb > memory_limit_kb)
+                    deferred_actions[deferred_count++] = candidate - graph->actions;
+                else if(running_count > 0 && available_memory_kb > 0 && estimated_memory_kb > available_memory_kb)
+                    deferred_actions[deferred_count++] = candidate - graph->actions;
+                else
+                    action = candidate;
+            }
+
+            for(size_t i = 0; i < deferred_count; ++i)
+                cbrew_graph_ready_push(graph, ready_actions, &ready_count, deferred_actions[i]);
+
+            if(action == NULL)
+                break;
+
+            char* cmd = cbrew_action_create_command(action);
+
+            action->signature = cbrew_hash_str(cmd);
+
+            // Launchers like ccache don't change the object file, so they aren't part of the signature
+            if(action->type == CBREW_ACTION_TYPE_COMPILE && action->args->toolchain->launcher != NULL)
+            {
+                char* launched_cmd = cbrew_create_str("%s %s", action->args->toolchain->launcher, cmd);
+                free(cmd);
+                cmd = launched_cmd;
+            }
+
+            char output_filepath[CBREW_FILEPATH_MAX];
+            cbrew_action_output_filepath(output_filepath, action);
+
+            char reason[CBREW_FILEPATH_MAX + 64];
+            const CbrewBool up_to_date = cbrew_action_is_up_to_date(graph, action, reason);
+
+            // Rewriting a whole archive for a few changed objects is wasteful, but the signature stays the one of the complete command
+            char* archive_update_cmd = NULL;
+            if(!up_to_date && action->type == CBREW_ACTION_TYPE_STATIC_LIB)
+                archive_update_cmd = cbrew_action_create_archive_update_command(graph, action);
+
+            if(archive_update_cmd != NULL)
+            {
+                free(cmd);
+                cmd = archive_update_cmd;
+            }
+
+            if(cbrew_get_explain())
+            {
+                cbrew_log_progress_clear();
+                CBREW_LOG_TRACE("%s: %s", output_filepath, up_to_date ? "is up to date" : reason);
+            }
+
+            // Actions that would be run count as succeeded, so their dependents are planned as well
+            if(!up_to_date && cbrew_get_dry_run())
+            {
+                cbrew_log_progress(++started_count, actions_count, action);
+                printf("%s\n", cmd);
+
+                action->state = CBREW_ACTION_STATE_SUCCEEDED;
+            }
+            else if(up_to_date)
+                action->state = CBREW_ACTION_STATE_UP_TO_DATE;
+            else if(action->type == CBREW_ACTION_TYPE_INSTALL || action->type == CBREW_ACTION_TYPE_SHARE || action->type == CBREW_ACTION_TYPE_BENCHMARK)
+            {
+                // Linking or copying a file is too fast to be worth starting a process, while benchmarks block the build until all of their samples are taken
+                cbrew_log_progress_clear();
+                CBREW_LOG_CMD("%s", cmd);
+                cbrew_log_progress(++started_count, actions_count, action);
+
+                action->start_time = cbrew_time_ms();
+
+                CbrewBool succeeded = CBREW_FALSE;
+                if(action->type == CBREW_ACTION_TYPE_BENCHMARK)
+                    succeeded = cbrew_action_run_benchmark(action, cmd);
+                else
+                    succeeded = cbrew_file_install(action->input, action->destination);
+
+                // The dependency file is shared as well, so it isn't pruned as stale from the object directory of the share action
+                if(succeeded && action->type == CBREW_ACTION_TYPE_SHARE)
+                {
+                    char dep_filepath[CBREW_FILEPATH_MAX];
+                    strcpy(dep_filepath, action->input);
+                    dep_filepath[strlen(dep_filepath) - 1] = 'd';
+
+                    char shared_dep_filepath[CBREW_FILEPATH_MAX];
+                    strcpy(shared_dep_filepath, action->destination);
+                    shared_dep_filepath[strlen(shared_dep_filepath) - 1] = 'd';
+
+                    succeeded = cbrew_file_install(dep_filepath, shared_dep_filepath);
+                }
+
+                action->state = succeeded ? CBREW_ACTION_STATE_SUCCEEDED : CBREW_ACTION_STATE_FAILED;
+                action->end_time = cbrew_time_ms();
+
+                // Benchmarks report their failures like the output of any other action, once they have finished
+                if(action->output != NULL)
+                {
+                    cbrew_log_progress_clear();
+
+                    fputs(action->output, stderr);
+                    fflush(stderr);
+
+                    free(action->output);
+                    action->output = NULL;
+                }
+
+                if(action->state == CBREW_ACTION_STATE_FAILED)
+                    result = CBREW_FALSE;
+            }
+
+            if(action->state != CBREW_ACTION_STATE_PENDING)
+            {
+                const size_t completed_action = action - graph->actions;
+
+                for(size_t i = dependents_offsets[completed_action]; i < dependents_offsets[completed_action + 1] && action->state != CBREW_ACTION_STATE_FAILED; ++i)
+                {
+                    if(--pending_dependencies[dependents[i]] == 0)
+                        cbrew_graph_ready_push(graph, ready_actions, &ready_count, dependents[i]);
+                }
+
+                if(up_to_date)
+                    ++started_count;
+
+                free(cmd);
+                continue;
+            }
+
+            cbrew_log_progress_clear();
+            CBREW_LOG_CMD("%s", cmd);
+            cbrew_log_progress(++started_count, actions_count, action);
+
+            // ar only replaces or adds members, so the members of deleted source files would stay inside an archive that is created from scratch
+            if(action->type == CBREW_ACTION_TYPE_STATIC_LIB && archive_update_cmd == NULL)
+                cbrew_file_delete(output_filepath);
+
+            // A previous build may have shared the object and dependency files of another config, which the compiler would overwrite through the hard links
+            if(action->type == CBREW_ACTION_TYPE_COMPILE)
+            {
+                char dep_filepath[CBREW_FILEPATH_MAX];
+                cbrew_config_dep_filepath(dep_filepath, action->config, action->input);
+
+                cbrew_file_delete(output_filepath);
+                cbrew_file_delete(dep_filepath);
+            }
+
+            action->start_time = cbrew_time_ms();
+
+            if(action->type == CBREW_ACTION_TYPE_TEST && action->project->test_timeout > 0)
+                action->deadline = action->start_time + action->project->test_timeout * 1000.0;
+
+            // Tests may start processes of their own, which have to be stopped together with the test once it times out
+            if(cbrew_process_start(&processes[running_count], cmd, CBREW_TRUE, action->deadline > 0.0))
+            {
+                action->state = CBREW_ACTION_STATE_RUNNING;
+                running_actions[running_count++] = action - graph->actions;
+                running_memory_kb += action->estimated_memory_kb;
+            }
+            else
+            {
+                action->state = CBREW_ACTION_STATE_FAILED;
+                action->end_time = cbrew_time_ms();
+                result = CBREW_FALSE;
+            }
+
+            free(cmd);
+        }
+
+        // Tokens that can't be used right now are returned, so other processes can use them
+        while(jobserver->tokens_count > 0 && jobserver->tokens_count + 1 > running_count)
+            cbrew_jobserver_release(jobserver);
+
+        if(running_count == 0)
+            break;
+
+        size_t finished = 0;
+        CbrewBool success = CBREW_FALSE;
+        size_t peak_memory_kb = 0;
+
+        // Tests that run too long are stopped, and waiting ends at the deadline of the next test that may run too long
+        const double now = cbrew_time_ms();
+        double nearest_deadline = 0.0;
+
+        for(size_t i = 0; i < running_count; ++i)
+        {
+            const double deadline = graph->actions[running_actions[i]].deadline;
+
+            if(deadline <= 0.0)
+                continue;
+
+            if(now >= deadline)
+                cbrew_process_kill(&processes[i]);
+            else if(nearest_deadline == 0.0 || deadline < nearest_deadline)
+                nearest_deadline = deadline;
+        }
+
+        int timeout_ms = -1;
+        if(waiting_for_token)
+            timeout_ms = 0;
+        else if(nearest_deadline > 0.0)
+            timeout_ms = (int) (nearest_deadline - now) + 1;
+
+        if(timeout_ms >= 0)
+        {
+            if(!cbrew_process_wait_any(processes, running_count, timeout_ms, &finished, &success, &peak_memory_kb))
+            {
+                if(waiting_for_token)
+                    cbrew_jobserver_acquire(jobserver, 20);
+
+                continue;
+            }
+        }
+        else if(!cbrew_process_wait_any(processes, running_count, -1, &finished, &success, &peak_memory_kb))
+        {
+            CBREW_LOG_ERROR("Failed to wait for running commands!");
+
+            for(size_t i = 0; i < running_count; ++i)
+            {
+                graph->actions[running_actions[i]].state = CBREW_ACTION_STATE_FAILED;
+                cbrew_string_builder_free(&processes[i].output);
+            }
+
+            result = CBREW_FALSE;
+            break;
+        }
+
+        const size_t finished_action = running_actions[finished];
+        CbrewStringBuilder output = processes[finished].output;
+
+        --running_count;
+        processes[finished] = processes[running_count];
+        running_actions[finished] = running_actions[running_count];
+
+        CbrewAction* action = &graph->actions[finished_action];
+        action->end_time = cbrew_time_ms();
+        action->peak_memory_kb = peak_memory_kb;
+
+        if(!success && action->deadline > 0.0 && action->end_time >= action->deadline)
+            cbrew_string_builder_append_format(&output, "Test timed out after %zu seconds\n", action->project->test_timeout);
+
+        // The output of every action is written at once, so the output of parallel actions never interleaves,
+        // but passing tests are only interesting if they fail
+        if(output.len > 0 && (action->type != CBREW_ACTION_TYPE_TEST || !success))
+        {
+            cbrew_log_progress_clear();
+
+            fwrite(output.data, sizeof(char), output.len, stderr);
+            fflush(stderr);
+        }
+
+        cbrew_string_builder_free(&output);
+
+        running_memory_kb -= action->estimated_memory_kb;
+
+        if(success)
+        {
+            action->state = CBREW_ACTION_STATE_SUCCEEDED;
+
+            char output_filepath[CBREW_FILEPATH_MAX];
+            cbrew_action_output_filepath(output_filepath, action);
+
+            CbrewHistoryEntry* entry = cbrew_history_get(&handler.history, output_filepath, CBREW_TRUE);
+            entry->duration = action->end_time - action->start_time;
+            entry->signature = action->signature;
+
+            if(peak_memory_kb > 0)
+                entry->peak_memory_kb = peak_memory_kb;
+
+            // Passed tests leave a stamp, so they are only run again once the test or its inputs change
+            if(action->type == CBREW_ACTION_TYPE_TEST)
+            {
+                FILE* stamp = fopen(output_filepath, "w");
+                if(stamp != NULL)
+                    fclose(stamp);
+            }
+
+            for(size_t i = dependents_offsets[finished_action]; i < dependents_offsets[finished_action + 1]; ++i)
+            {
+                if(--pending_dependencies[dependents[i]] == 0)
+                    cbrew_graph_ready_push(graph, ready_actions, &ready_count, dependents[i]);
+            }
+        }
+        else
+        {
+            action->state = CBREW_ACTION_STATE_FAILED;
+            result = CBREW_FALSE;
+
+            // An output that is left behind by the failed command must not be reused by the next build
+            char output_filepath[CBREW_FILEPATH_MAX];
+            cbrew_action_output_filepath(output_filepath, action);
+
+            CbrewHistoryEntry* entry = cbrew_history_get(&handler.history, output_filepath, CBREW_FALSE);
+            if(entry != NULL)
+                entry->signature = 0;
+
+            if(action->type == CBREW_ACTION_TYPE_TEST)
+                cbrew_file_delete(output_filepath);
+
+            // Stop building the failed config, other configs are independent of it, and a failed test doesn't affect the other tests
+            for(size_t i = 0; i < actions_count && !cbrew_get_keep_going() && action->type != CBREW_ACTION_TYPE_TEST; ++i)
+            {
+                CbrewAction* other = &graph->actions[i];
+
+                if(other->state == CBREW_ACTION_STATE_PENDING && other->project == action->project && other->config == action->config)
+                    other->state = CBREW_ACTION_STATE_SKIPPED;
+            }
+        }
+    }
+
+    // Actions whose dependencies failed never became ready
+    for(size_t i = 0; i < actions_count; ++i)
+    {
+        if(graph->actions[i].state == CBREW_ACTION_STATE_PENDING)
+        {
+            graph->actions[i].state = CBREW_ACTION_STATE_SKIPPED;
+            result = CBREW_FALSE;
+        }
+    }
+
+    if(!cbrew_get_dry_run() && (cbrew_dir_exists(".cbrew") || cbrew_dir_create(".cbrew")))
+    {
+        if(!cbrew_history_save(&handler.history, CBREW_HISTORY_FILEPATH))
+            CBREW_LOG_WARN("Failed to save the build history to %s!", CBREW_HISTORY_FILEPATH);
+
+        if(handler.include_cache_loaded && !cbrew_include_cache_save(&handler.include_cache, CBREW_INCLUDE_CACHE_FILEPATH))
+            CBREW_LOG_WARN("Failed to save the include cache to %s!", CBREW_INCLUDE_CACHE_FILEPATH);
+    }
+
+    cbrew_log_progress_clear();
+
+    free(processes);
+    free(running_actions);
+    free(ready_actions);
+    free(deferred_actions);
+    free(dependents);
+    free(dependents_offsets);
+    free(pending_dependencies);
+
+    return result;
+}
+
+void cbrew_graph_log_failures(const CbrewGraph* graph)
+{
+    CBREW_ASSERT(graph != NULL);
+
+    size_t failed_count = 0;
+    size_t skipped_count = 0;
+
+    for(size_t i = 0; i < graph->actions_count; ++i)
+    {
+        if(graph->actions[i].state == CBREW_ACTION_STATE_FAILED)
+            ++failed_count;
+        else if(graph->actions[i].state == CBREW_ACTION_STATE_SKIPPED)
+            ++skipped_count;
+    }
+
+    if(failed_count == 0)
+        return;
+
+    CBREW_LOG_ERROR("%zu action(s) failed, %zu action(s) were skipped:", failed_count, skipped_count);
+
+    for(size_t i = 0; i < graph->actions_count; ++i)
+    {
+        const CbrewAction* action = &graph->actions[i];
+
+        if(action->state != CBREW_ACTION_STATE_FAILED)
+            continue;
+
+        char output_filepath[CBREW_FILEPATH_MAX];
+        cbrew_action_output_filepath(output_filepath, action);
+
+        // The output of the action has already been written when it finished
+        CBREW_LOG_ERROR("  %s%s%s (%s%s%s) -> %s", CBREW_CONSOLE_COLOR_PROJECT, action->project->name, CBREW_CONSOLE_COLOR_ERROR, CBREW_CONSOLE_COLOR_CONFIG, action->config->name, CBREW_CONSOLE_COLOR_ERROR, output_filepath);
+    }
+}
+
+void cbrew_graph_record_stats(const CbrewGraph* graph, double wall_time, CbrewBool success)
+{
+    CBREW_ASSERT(graph != NULL);
+
+    CbrewStatsRecord record;
+    memset(&record, 0, sizeof(CbrewStatsRecord));
+
+    record.actions_count = graph->actions_count;
+
+    CbrewStringBuilder configs;
+    memset(&configs, 0, sizeof(CbrewStringBuilder));
+
+    for(size_t i = 0; i < graph->actions_count; ++i)
+    {
+        const CbrewAction* action = &graph->actions[i];
+
+        switch(action->state)
+        {
+            case CBREW_ACTION_STATE_SUCCEEDED: ++record.run_count; break;
+            case CBREW_ACTION_STATE_FAILED: ++record.run_count; ++record.failed_count; break;
+            case CBREW_ACTION_STATE_UP_TO_DATE: ++record.up_to_date_count; break;
+            default: ++record.skipped_count; break;
+        }
+
+        if(action->peak_memory_kb > record.peak_memory_kb)
+            record.peak_memory_kb = action->peak_memory_kb;
+
+        // Every config is written once, at its first action
+        CbrewBool first_action = CBREW_TRUE;
+        for(size_t j = 0; j < i && first_action; ++j)
+            first_action = graph->actions[j].config != action->config;
+
+        if(!first_action)
+            continue;
+
+        double config_start = 0.0;
+        double config_end = 0.0;
+
+        for(size_t j = i; j < graph->actions_count; ++j)
+        {
+            const CbrewAction* config_action = &graph->actions[j];
+
+            if(config_action->config != action->config || config_action->start_time == 0.0)
+                continue;
+
+            if(config_start == 0.0 || config_action->start_time < config_start)
+                config_start = config_action->start_time;
+
+            if(config_action->end_time > config_end)
+                config_end = config_action->end_time;
+        }
+
+        // Configs whose actions were all up to date took no time
+        if(config_end > config_start)
+            cbrew_string_builder_append_format(&configs, "%s%s:%s=%.0lf", configs.len == 0 ? "" : ",", action->project->name, action->config->name, config_end - config_start);
+    }
+
+    // The order of the targets doesn't change what is built
+    CbrewStringBuilder selection;
+    memset(&selection, 0, sizeof(CbrewStringBuilder));
+
+    char** targets = malloc((handler.targets_count + 1) * sizeof(char*));
+    memcpy(targets, handler.targets, handler.targets_count * sizeof(char*));
+    qsort(targets, handler.targets_count, sizeof(char*), cbrew_str_compare);
+
+    for(size_t i = 0; i < handler.targets_count; ++i)
+        cbrew_string_builder_append_format(&selection, i == 0 ? "%s" : ",%s", targets[i]);
+
+    free(targets);
+
+    // Names are separated by spaces inside the record
+    for(size_t i = 0; i < configs.len; ++i)
+    {
+        if(configs.data[i] == ' ')
+            configs.data[i] = '_';
+    }
+
+    for(size_t i = 0; i < selection.len; ++i)
+    {
+        if(selection.data[i] == ' ')
+            selection.data[i] = '_';
+    }
+
+    char* line = cbrew_create_str("%llu %d %.0lf %zu %zu %zu %zu %zu %zu %s %s\n", (unsigned long long) time(NULL), success ? 1 : 0, wall_time, record.actions_count,
+        record.run_count, record.up_to_date_count, record.failed_count, record.skipped_count, record.peak_memory_kb, configs.len > 0 ? configs.data : "-", selection.len > 0 ? selection.data : "*");
+
+    cbrew_string_builder_free(&configs);
+    cbrew_string_builder_free(&selection);
+
+    // Only the most recent records are kept, so the statistics never grow without bounds
+    char* stats = cbrew_file_read(CBREW_STATS_FILEPATH, NULL);
+
+    size_t records_count = 0;
+    for(const char* c = stats; c != NULL && *c != '\0'; ++c)
+    {
+        if(*c == '\n')
+            ++records_count;
+    }
+
+    FILE* f = NULL;
+
+    if(records_count >= CBREW_STATS_MAX_RECORDS)
+    {
+        const char* kept = stats;
+        for(size_t i = 0; i <= records_count - CBREW_STATS_MAX_RECORDS && kept != NULL; ++i)
+            kept = strchr(kept, '\n') + 1;
+
+        f = fopen(CBREW_STATS_FILEPATH, "w");
+        if(f != NULL)
+            fputs(kept, f);
+    }
+    else
+        f = fopen(CBREW_STATS_FILEPATH, "a");
+
+    if(f != NULL)
+    {
+        fputs(line, f);
+        fclose(f);
+    }
+    else
+        CBREW_LOG_WARN("Failed to write the build statistics to %s!", CBREW_STATS_FILEPATH);
+
+    free(stats);
+    free(line);
+}
+
+void cbrew_graph_log_critical_path(const CbrewGraph* graph, double wall_time)
+{
+    CBREW_ASSERT(graph != NULL);
+
+    const size_t actions_count = graph->actions_count;
+
+    if(actions_count == 0)
+        return;
+
+    // The finish time of an action, if it had started as soon as its dependencies finished
+    double* finish_times = calloc(actions_count, sizeof(double));
+    size_t* predecessors = malloc(actions_count * sizeof(size_t));
+
+    size_t last_action = 0;
+
+    size_t* order = cbrew_graph_topological_order(graph);
+
+    for(size_t i = 0; i < actions_count; ++i)
+    {
+        const size_t current = order[i];
+        const CbrewAction* action = &graph->actions[current];
+
+        double start_time = 0.0;
+        predecessors[current] = actions_count;
+
+        for(size_t j = 0; j < action->dependencies_count; ++j)
+        {
+            const size_t dependency = action->dependencies[j];
+
+            if(finish_times[dependency] > start_time)
+            {
+                start_time = finish_times[dependency];
+                predecessors[current] = dependency;
+            }
+        }
+
+        const CbrewBool ran = action->state == CBREW_ACTION_STATE_SUCCEEDED || action->state == CBREW_ACTION_STATE_FAILED;
+        finish_times[current] = start_time + (ran ? action->end_time - action->start_time : 0.0);
+
+        if(finish_times[current] > finish_times[last_action])
+            last_action = current;
+    }
+
+    const double critical_path = finish_times[last_action];
+
+    if(critical_path > 0.0)
+    {
+        const double overhead = wall_time > critical_path ? (wall_time / critical_path - 1.0) * 100.0 : 0.0;
+
+        CBREW_LOG_INFO("Actions took %.0lf%% longer than their critical path of %.0lfms %s(%.0lfms)", overhead, critical_path, CBREW_CONSOLE_COLOR_TIME, wall_time);
+
+        // The chain is collected backwards from its last action, but logged in the order the actions ran
+        size_t chain_count = 0;
+        for(size_t current = last_action; current < actions_count; current = predecessors[current])
+            order[chain_count++] = current;
+
+        for(size_t i = chain_count; i > 0; --i)
+        {
+            const CbrewAction* action = &graph->actions[order[i - 1]];
+
+            if(action->state != CBREW_ACTION_STATE_SUCCEEDED && action->state != CBREW_ACTION_STATE_FAILED)
+                continue;
+
+            char output_filepath[CBREW_FILEPATH_MAX];
+            cbrew_action_output_filepath(output_filepath, action);
+
+            CBREW_LOG_TRACE("  %s %s(%.0lfms)", output_filepath, CBREW_CONSOLE_COLOR_TIME, action->end_time - action->start_time);
+        }
+    }
+
+    free(order);
+    free(finish_times);
+    free(predecessors);
+}
+
+void cbrew_graph_free(CbrewGraph* graph)
+{
+    CBREW_ASSERT(graph != NULL);
+
+    for(size_t i = 0; i < graph->actions_count; ++i)
+    {
+        free(graph->actions[i].input);
+        free(graph->actions[i].destination);
+        free(graph->actions[i].compile_args);
+        free(graph->actions[i].dependencies);
+        free(graph->actions[i].output);
+    }
+
+    free(graph->actions);
+
+    for(size_t i = 0; i < graph->config_args_count; ++i)
+    {
+        CbrewConfigArgs* args = graph->config_args[i];
+
+        free(args->compile_args);
+        free(args->link_args);
+        free(args->dynamic_lib_args);
+        free(args->links);
+        cbrew_string_builder_free(&args->obj_files);
+
+        free(args);
+    }
+
+    free(graph->config_args);
+
+    memset(graph, 0, sizeof(CbrewGraph));
+}
+
+CbrewBool cbrew_action_run(CbrewActionType type, const CbrewProject* project, const CbrewConfig* config, const char* input)
+{
+    CbrewGraph graph;
+    memset(&graph, 0, sizeof(CbrewGraph));
+
+    cbrew_graph_add_action(&graph, type, project, config, input);
+
+    CbrewBool result = cbrew_graph_run(&graph);
+
+    cbrew_graph_free(&graph);
+
+    return result;
+}
+
+void cbrew_action_output_filepath(char* filepath, const CbrewAction* action)
+{
+    CBREW_ASSERT(filepath != NULL);
+    CBREW_ASSERT(action != NULL);
+
+    const CbrewProject* project = action->project;
+    const CbrewConfig* config = action->config;
+
+    switch(action->type)
+    {
+        case CBREW_ACTION_TYPE_COMPILE: cbrew_config_obj_filepath(filepath, config, action->input); break;
+        case CBREW_ACTION_TYPE_LINK:
+        {
+            if(action->input != NULL)
+                cbrew_config_test_filepath(filepath, config, action->input);
+            else
+                sprintf(filepath, "%s%c%s", config->target_dir, CBREW_PATH_SEPARATOR, project->name);
+
+            break;
+        }
+
+        case CBREW_ACTION_TYPE_STATIC_LIB: sprintf(filepath, "%s%c%s%s.%s", config->target_dir, CBREW_PATH_SEPARATOR, CBREW_LIB_PREFIX, project->name, CBREW_STATIC_LIB_EXTENSION); break;
+        case CBREW_ACTION_TYPE_DYNAMIC_LIB: sprintf(filepath, "%s%c%s.%s", config->target_dir, CBREW_PATH_SEPARATOR, project->name, CBREW_DYNAMIC_LIB_EXTENSION); break;
+        case CBREW_ACTION_TYPE_INSTALL: strcpy(filepath, action->destination); break;
+        case CBREW_ACTION_TYPE_SHARE: strcpy(filepath, action->destination); break;
+        case CBREW_ACTION_TYPE_TEST: cbrew_config_test_stamp_filepath(filepath, config, action->input); break;
+        case CBREW_ACTION_TYPE_BENCHMARK: cbrew_config_benchmark_results_filepath(filepath, config, action->input); break;
+        case CBREW_ACTION_TYPE_STEP: strcpy(filepath, action->step->outputs[0]); break;
+        default: CBREW_ASSERT(CBREW_FALSE);
+    }
+}
+
+CbrewBool cbrew_action_is_up_to_date(const CbrewGraph* graph, const CbrewAction* action, char* reason)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(action != NULL);
+
+    char discarded_reason[CBREW_FILEPATH_MAX + 64];
+    if(reason == NULL)
+        reason = discarded_reason;
+
+    // Every run of a benchmark is another measurement, so benchmarks are never up to date
+    if(action->type == CBREW_ACTION_TYPE_BENCHMARK)
+    {
+        strcpy(reason, "benchmarks are always run");
+        return CBREW_FALSE;
+    }
+
+    char output_filepath[CBREW_FILEPATH_MAX];
+    cbrew_action_output_filepath(output_filepath, action);
+
+    uint64_t output_mtime = cbrew_file_mtime(output_filepath);
+    if(output_mtime == 0)
+    {
+        strcpy(reason, "output is missing");
+        return CBREW_FALSE;
+    }
+
+    // A step is only as recent as the oldest of its outputs
+    for(size_t i = 1; action->type == CBREW_ACTION_TYPE_STEP && i < action->step->outputs_count; ++i)
+    {
+        const uint64_t mtime = cbrew_file_mtime(action->step->outputs[i]);
+
+        if(mtime == 0)
+        {
+            sprintf(reason, "output %s is missing", action->step->outputs[i]);
+            return CBREW_FALSE;
+        }
+
+        if(mtime < output_mtime)
+            output_mtime = mtime;
+    }
+
+    // The debug information of an object file is useless without its split debug information file
+    if(action->type == CBREW_ACTION_TYPE_COMPILE && action->split_dwarf)
+    {
+        char dwo_filepath[CBREW_FILEPATH_MAX];
+        cbrew_config_dwo_filepath(dwo_filepath, action->config, action->input);
+
+        if(!cbrew_file_exists(dwo_filepath))
+        {
+            sprintf(reason, "output %s is missing", dwo_filepath);
+            return CBREW_FALSE;
+        }
+    }
+
+    // Installed and shared files keep the modification time of their source, so any other modification time means that the source has changed
+    if(action->type == CBREW_ACTION_TYPE_INSTALL || action->type == CBREW_ACTION_TYPE_SHARE)
+    {
+        for(size_t i = 0; i < action->dependencies_count; ++i)
+        {
+            if(graph->actions[action->dependencies[i]].state == CBREW_ACTION_STATE_SUCCEEDED)
+            {
+                sprintf(reason, "input %s was rebuilt", action->input);
+                return CBREW_FALSE;
+            }
+        }
+
+        if(cbrew_file_mtime(action->input) != output_mtime)
+        {
+            sprintf(reason, "input %s changed", action->input);
+            return CBREW_FALSE;
+        }
+
+        return CBREW_TRUE;
+    }
+
+    // Changed flags or defines require running the action again, even if no file has changed
+    const CbrewHistoryEntry* entry = cbrew_history_get(&handler.history, output_filepath, CBREW_FALSE);
+    if(entry == NULL || entry->signature == 0)
+    {
+        strcpy(reason, "no successful run has been recorded");
+        return CBREW_FALSE;
+    }
+
+    if(entry->signature != action->signature)
+    {
+        strcpy(reason, "command changed");
+        return CBREW_FALSE;
+    }
+
+    if(action->type == CBREW_ACTION_TYPE_COMPILE)
+    {
+        char* dependency_str = cbrew_project_config_file_dependencies(action->project, action->config, action->input);
+        if(dependency_str == NULL)
+        {
+            strcpy(reason, "dependencies are unknown");
+            return CBREW_FALSE;
+        }
+
+        char newer_prerequisite[CBREW_FILEPATH_MAX];
+        const CbrewBool result = cbrew_file_is_newer_than_rule(output_filepath, dependency_str, newer_prerequisite);
+
+        free(dependency_str);
+
+        if(!result)
+            sprintf(reason, "dependency %s is newer", newer_prerequisite);
+
+        return result;
+    }
+
+    // Products are created from the outputs of their dependencies, which are either object files or the products of upstream projects
+    for(size_t i = 0; i < action->dependencies_count; ++i)
+    {
+        const CbrewAction* dependency = &graph->actions[action->dependencies[i]];
+
+        char dependency_filepath[CBREW_FILEPATH_MAX];
+        cbrew_action_output_filepath(dependency_filepath, dependency);
+
+        if(dependency->state == CBREW_ACTION_STATE_SUCCEEDED)
+        {
+            sprintf(reason, "input %s was rebuilt", dependency_filepath);
+            return CBREW_FALSE;
+        }
+
+        if(cbrew_file_mtime(dependency_filepath) > output_mtime)
+        {
+            sprintf(reason, "input %s is newer", dependency_filepath);
+            return CBREW_FALSE;
+        }
+    }
+
+    const CbrewProject* project = action->project;
+
+    const char** inputs = NULL;
+    size_t inputs_count = 0;
+
+    if(action->type == CBREW_ACTION_TYPE_TEST)
+    {
+        inputs = project->test_inputs;
+        inputs_count = project->test_inputs_count;
+    }
+    else if(action->type == CBREW_ACTION_TYPE_STEP)
+    {
+        inputs = action->step->inputs;
+        inputs_count = action->step->inputs_count;
+    }
+
+    // Tests and steps read files that no action creates, so they have to be compared on their own
+    for(size_t i = 0; i < inputs_count; ++i)
+    {
+        char newer_filepath[CBREW_FILEPATH_MAX];
+
+        if(cbrew_wildcard_find_newer_file(inputs[i], output_mtime, newer_filepath))
+        {
+            sprintf(reason, "input %s changed", newer_filepath);
+            return CBREW_FALSE;
+        }
+    }
+
+    if(action->type == CBREW_ACTION_TYPE_STEP)
+        return CBREW_TRUE;
+
+    // Libraries may also be created by another build, so their files are compared as well
+
+    for(size_t i = 0; i < project->links_count; ++i)
+    {
+        const char* link = project->links[i];
+        const char* last_slash = strrchr(link, CBREW_PATH_SEPARATOR);
+
+        // Libraries without a directory are found by the linker inside the system directories
+        if(last_slash == NULL)
+            continue;
+
+        const int dir_len = (int) (last_slash - link);
+        const char* name = last_slash + 1;
+
+        char library_filepaths[3][CBREW_FILEPATH_MAX];
+        sprintf(library_filepaths[0], "%.*s%c%s%s.%s", dir_len, link, CBREW_PATH_SEPARATOR, CBREW_LIB_PREFIX, name, CBREW_STATIC_LIB_EXTENSION);
+        sprintf(library_filepaths[1], "%.*s%c%s%s.%s", dir_len, link, CBREW_PATH_SEPARATOR, CBREW_LIB_PREFIX, name, CBREW_DYNAMIC_LIB_EXTENSION);
+        sprintf(library_filepaths[2], "%.*s%c%s.%s", dir_len, link, CBREW_PATH_SEPARATOR, name, CBREW_DYNAMIC_LIB_EXTENSION);
+
+        for(size_t j = 0; j < 3; ++j)
+        {
+            if(cbrew_file_mtime(library_filepaths[j]) > output_mtime)
+            {
+                sprintf(reason, "upstream library %s changed", library_filepaths[j]);
+                return CBREW_FALSE;
+            }
+        }
+    }
+
+    return CBREW_TRUE;
+}
+
+char* cbrew_action_create_command(const CbrewAction* action)
+{
+    CBREW_ASSERT(action != NULL);
+    CBREW_ASSERT(action->args != NULL);
+
+    const CbrewProject* project = action->project;
+    const CbrewConfig* config = action->config;
+    const CbrewConfigArgs* args = action->args;
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    switch(action->type)
+    {
+        case CBREW_ACTION_TYPE_COMPILE:
+        {
+            char obj_filepath[CBREW_FILEPATH_MAX];
+            cbrew_config_obj_filepath(obj_filepath, config, action->input);
+
+            char dep_filepath[CBREW_FILEPATH_MAX];
+            cbrew_config_dep_filepath(dep_filepath, config, action->input);
+
+            const char* compile_args = action->compile_args != NULL ? action->compile_args : args->compile_args;
+
+            // Without a dependency file, the included headers are found by scanning the source file instead
+            if(args->toolchain->capabilities & CBREW_TOOLCHAIN_CAPABILITY_DEPFILES)
+                cbrew_string_builder_append_format(&sb, "%s %s-MMD -MF \"%s\" -c -o \"%s\" \"%s\"", args->toolchain->compiler, compile_args, dep_filepath, obj_filepath, action->input);
+            else
+                cbrew_string_builder_append_format(&sb, "%s %s-c -o \"%s\" \"%s\"", args->toolchain->compiler, compile_args, obj_filepath, action->input);
+
+            break;
+        }
+
+        case CBREW_ACTION_TYPE_LINK:
+        {
+            // Test executables are linked from the object file of their own source file only
+            if(action->input != NULL)
+            {
+                char obj_filepath[CBREW_FILEPATH_MAX];
+                cbrew_config_obj_filepath(obj_filepath, config, action->input);
+
+                char test_filepath[CBREW_FILEPATH_MAX];
+                cbrew_config_test_filepath(test_filepath, config, action->input);
+
+                cbrew_string_builder_append_format(&sb, "%s %s-o \"%s\" \"%s\" %s", args->toolchain->compiler, args->link_args, test_filepath, obj_filepath, args->links);
+
+                break;
+            }
+
+            char* obj_files = args->obj_files.len > 0 ? strdup(args->obj_files.data) : cbrew_config_create_obj_files_str(config);
+
+            cbrew_string_builder_append_format(&sb, "%s %s-o \"%s%c%s\" ", args->toolchain->compiler, args->link_args, config->target_dir, CBREW_PATH_SEPARATOR, project->name);
+            cbrew_string_builder_append(&sb, obj_files);
+            cbrew_string_builder_append(&sb, " ");
+            cbrew_string_builder_append(&sb, args->links);
+
+            free(obj_files);
+
+            break;
+        }
+
+        case CBREW_ACTION_TYPE_STATIC_LIB:
+        {
+            char* obj_files = args->obj_files.len > 0 ? strdup(args->obj_files.data) : cbrew_config_create_obj_files_str(config);
+
+            cbrew_string_builder_append_format(&sb, "%s rcs%s \"%s%c%s%s.%s\" ", args->toolchain->archiver, config->thin_archive ? " --thin" : "", config->target_dir, CBREW_PATH_SEPARATOR, CBREW_LIB_PREFIX, project->name, CBREW_STATIC_LIB_EXTENSION);
+            cbrew_string_builder_append(&sb, obj_files);
+
+            free(obj_files);
+
+            break;
+        }
+
+        case CBREW_ACTION_TYPE_DYNAMIC_LIB:
+        {
+            char* obj_files = args->obj_files.len > 0 ? strdup(args->obj_files.data) : cbrew_config_create_obj_files_str(config);
+
+            cbrew_string_builder_append_format(&sb, "%s -shared %s-o \"%s%c%s.%s\" ", args->toolchain->compiler, args->dynamic_lib_args, config->target_dir, CBREW_PATH_SEPARATOR, project->name, CBREW_DYNAMIC_LIB_EXTENSION);
+            cbrew_string_builder_append(&sb, obj_files);
+
+            free(obj_files);
+
+            break;
+        }
+
+        case CBREW_ACTION_TYPE_INSTALL:
+        case CBREW_ACTION_TYPE_SHARE:
+        {
+            // Files are installed and shared by cbrew itself, so the command only describes the action
+#ifdef CBREW_PLATFORM_WINDOWS
+            cbrew_string_builder_append_format(&sb, "copy /Y \"%s\" \"%s\"", action->input, action->destination);
+#else
+            cbrew_string_builder_append_format(&sb, "cp -p \"%s\" \"%s\"", action->input, action->destination);
+#endif
+
+            break;
+        }
+
+        case CBREW_ACTION_TYPE_TEST:
+        {
+            char test_filepath[CBREW_FILEPATH_MAX];
+            cbrew_config_test_filepath(test_filepath, config, action->input);
+
+            cbrew_string_builder_append_format(&sb, "\"%s\"", test_filepath);
+
+            break;
+        }
+
+        case CBREW_ACTION_TYPE_STEP: cbrew_string_builder_append(&sb, action->step->command); break;
+
+        case CBREW_ACTION_TYPE_BENCHMARK:
+        {
+            char benchmark_filepath[CBREW_FILEPATH_MAX];
+            cbrew_config_test_filepath(benchmark_filepath, config, action->input);
+
+            char results_filepath[CBREW_FILEPATH_MAX];
+            cbrew_config_benchmark_results_filepath(results_filepath, config, action->input);
+
+            // Benchmarks are pinned to the last processor, which usually handles fewer interrupts than the first one
+            const size_t processor = cbrew_processor_count() - 1;
+
+#ifdef CBREW_PLATFORM_WINDOWS
+            cbrew_string_builder_append_format(&sb, "start \"\" /b /wait /affinity %llx \"%s\" > \"%s\"", 1ULL << (processor % 64), benchmark_filepath, results_filepath);
+#else
+            char taskset_filepath[CBREW_FILEPATH_MAX];
+            if(cbrew_program_filepath(taskset_filepath, "taskset"))
+                cbrew_string_builder_append_format(&sb, "taskset -c %zu ", processor);
+
+            cbrew_string_builder_append_format(&sb, "\"%s\" > \"%s\"", benchmark_filepath, results_filepath);
+#endif
+
+            break;
+        }
+
+        default: CBREW_ASSERT(CBREW_FALSE);
+    }
+
+    return cbrew_string_builder_release(&sb);
+}
+
+char* cbrew_action_create_archive_update_command(const CbrewGraph* graph, const CbrewAction* action)
+{
+    CBREW_ASSERT(graph != NULL);
+    CBREW_ASSERT(action != NULL);
+    CBREW_ASSERT(action->type == CBREW_ACTION_TYPE_STATIC_LIB);
+
+    char output_filepath[CBREW_FILEPATH_MAX];
+    cbrew_action_output_filepath(output_filepath, action);
+
+    const uint64_t output_mtime = cbrew_file_mtime(output_filepath);
+    if(output_mtime == 0)
+        return NULL;
+
+    // The signature covers the complete list of objects, so a matching signature means that no member has been added or removed since
+    const CbrewHistoryEntry* entry = cbrew_history_get(&handler.history, output_filepath, CBREW_FALSE);
+    if(entry == NULL || entry->signature == 0 || entry->signature != action->signature)
+        return NULL;
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    cbrew_string_builder_append_format(&sb, "%s rcs%s \"%s\"", action->args->toolchain->archiver, action->config->thin_archive ? " --thin" : "", output_filepath);
+
+    size_t changed_count = 0;
+
+    for(size_t i = 0; i < action->dependencies_count; ++i)
+    {
+        const CbrewAction* dependency = &graph->actions[action->dependencies[i]];
+
+        if(dependency->config != action->config || (dependency->type != CBREW_ACTION_TYPE_COMPILE && dependency->type != CBREW_ACTION_TYPE_SHARE))
+            continue;
+
+        char obj_filepath[CBREW_FILEPATH_MAX];
+        cbrew_action_output_filepath(obj_filepath, dependency);
+
+        if(dependency->state == CBREW_ACTION_STATE_SUCCEEDED || cbrew_file_mtime(obj_filepath) > output_mtime)
+        {
+            cbrew_string_builder_append_format(&sb, " \"%s\"", obj_filepath);
+            ++changed_count;
+        }
+    }
+
+    if(changed_count == 0)
+    {
+        cbrew_string_builder_free(&sb);
+        return NULL;
+    }
+
+    return cbrew_string_builder_release(&sb);
+}
+
+/* Benchmarks */
+
+CbrewBool cbrew_action_run_benchmark(CbrewAction* action, const char* cmd)
+{
+    CBREW_ASSERT(action != NULL);
+    CBREW_ASSERT(action->type == CBREW_ACTION_TYPE_BENCHMARK);
+    CBREW_ASSERT(cmd != NULL);
+
+    const CbrewProject* project = action->project;
+
+    char benchmark_filepath[CBREW_FILEPATH_MAX];
+    cbrew_config_test_filepath(benchmark_filepath, action->config, action->input);
+
+    char results_filepath[CBREW_FILEPATH_MAX];
+    cbrew_action_output_filepath(results_filepath, action);
+
+    CbrewBenchmarkMetric* metrics = NULL;
+    size_t metrics_count = 0;
+    size_t metrics_capacity = 0;
+
+    CbrewBool success = CBREW_TRUE;
+
+    // The first run only warms up caches and is never measured
+    for(size_t i = 0; i <= project->benchmark_samples && success; ++i)
+    {
+        CbrewProcess process;
+        size_t index = 0;
+        CbrewBool sample_success = CBREW_FALSE;
+
+        success = cbrew_process_start(&process, cmd, CBREW_FALSE, CBREW_FALSE) && cbrew_process_wait_any(&process, 1, -1, &index, &sample_success, NULL) && sample_success;
+
+        char* results = cbrew_file_read(results_filepath, NULL);
+
+        if(!success)
+            action->output = cbrew_create_str("%sBenchmark %s failed\n", results != NULL ? results : "", benchmark_filepath);
+        else if(i > 0 && results != NULL)
+            cbrew_benchmark_parse_results(results, &metrics, &metrics_count, &metrics_capacity);
+
+        free(results);
+    }
+
+    if(success && metrics_count == 0)
+    {
+        action->output = cbrew_create_str("Benchmark %s reported no metrics, expected lines like \"BENCH <metric> <value> [unit]\"\n", benchmark_filepath);
+        success = CBREW_FALSE;
+    }
+
+    char* history = success ? cbrew_file_read(CBREW_BENCHMARKS_FILEPATH, NULL) : NULL;
+
+    CbrewStringBuilder records;
+    memset(&records, 0, sizeof(CbrewStringBuilder));
+
+    CbrewStringBuilder regressions;
+    memset(&regressions, 0, sizeof(CbrewStringBuilder));
+
+    const unsigned long long now = (unsigned long long) time(NULL);
+
+    for(size_t i = 0; i < metrics_count && success; ++i)
+    {
+        CbrewBenchmarkMetric* metric = &metrics[i];
+
+        double median = 0.0;
+        double p95 = 0.0;
+        double stddev = 0.0;
+        cbrew_samples_summarize(metric->samples, metric->samples_count, &median, &p95, &stddev);
+
+        const char* unit = metric->unit[0] != '\0' ? metric->unit : "-";
+        cbrew_string_builder_append_format(&records, "%llu %.17g %.17g %.17g %zu %s %s %s\n", now, median, p95, stddev, metric->samples_count, metric->name, unit, benchmark_filepath);
+
+        double baseline = 0.0;
+        const CbrewBool has_baseline = cbrew_benchmark_baseline(history, benchmark_filepath, metric->name, &baseline) && baseline > 0.0;
+        const double change = has_baseline ? (median - baseline) / baseline * 100.0 : 0.0;
+
+        cbrew_log_progress_clear();
+
+        if(has_baseline)
+            CBREW_LOG_INFO("%s %s: median %g%s, p95 %g%s, stddev %g%s %s(%+.1lf%% compared to %g%s)", benchmark_filepath, metric->name, median, metric->unit, p95, metric->unit, stddev, metric->unit, CBREW_CONSOLE_COLOR_TIME, change, baseline, metric->unit);
+        else
+            CBREW_LOG_INFO("%s %s: median %g%s, p95 %g%s, stddev %g%s", benchmark_filepath, metric->name, median, metric->unit, p95, metric->unit, stddev, metric->unit);
+
+        if(project->benchmark_fail_threshold > 0.0 && change > project->benchmark_fail_threshold)
+            cbrew_string_builder_append_format(&regressions, "Benchmark %s regressed: %s is %.1lf%% slower than its baseline of %g%s\n", benchmark_filepath, metric->name, change, baseline, metric->unit);
+        else if(project->benchmark_warn_threshold > 0.0 && change > project->benchmark_warn_threshold)
+            CBREW_LOG_WARN("%s %s is %.1lf%% slower than its baseline of %g%s!", benchmark_filepath, metric->name, change, baseline, metric->unit);
+    }
+
+    // Regressions that fail the build aren't recorded, so they can't become the baseline by running the benchmark often enough
+    if(regressions.len > 0)
+    {
+        action->output = cbrew_string_builder_release(&regressions);
+        success = CBREW_FALSE;
+    }
+    else if(success)
+    {
+        FILE* f = fopen(CBREW_BENCHMARKS_FILEPATH, "a");
+        if(f != NULL)
+        {
+            fputs(records.data, f);
+            fclose(f);
+        }
+        else
+            CBREW_LOG_WARN("Failed to append the benchmark results to %s!", CBREW_BENCHMARKS_FILEPATH);
+    }
+
+    cbrew_string_builder_free(&regressions);
+    cbrew_string_builder_free(&records);
+    free(history);
+
+    for(size_t i = 0; i < metrics_count; ++i)
+        free(metrics[i].samples);
+
+    free(metrics);
+
+    return success;
+}
+
+void cbrew_benchmark_parse_results(const char* results, CbrewBenchmarkMetric** metrics, size_t* metrics_count, size_t* metrics_capacity)
+{
+    CBREW_ASSERT(results != NULL);
+    CBREW_ASSERT(metrics != NULL);
+    CBREW_ASSERT(metrics_count != NULL);
+    CBREW_ASSERT(metrics_capacity != NULL);
+
+    for(const char* line = results; line != NULL; line = strchr(line, '\n'), line = line == NULL ? NULL : line + 1)
+    {
+        if(strncmp(line, "BENCH ", 6) != 0)
+            continue;
+
+        char name[64] = { 0 };
+        char unit[16] = { 0 };
+        double value = 0.0;
+
+        // A unit on the next line must not be mistaken for the unit of this metric
+        const char* line_end = strchr(line, '\n');
+        const int line_len = line_end != NULL ? (int) (line_end - line) : (int) strlen(line);
+
+        char metric_line[256];
+        snprintf(metric_line, sizeof(metric_line), "%.*s", line_len, line);
+
+        if(sscanf(metric_line + 6, "%63s %lf %15s", name, &value, unit) < 2)
+            continue;
+
+        CbrewBenchmarkMetric* metric = NULL;
+
+        for(size_t i = 0; i < *metrics_count && metric == NULL; ++i)
+        {
+            if(strcmp((*metrics)[i].name, name) == 0)
+                metric = &(*metrics)[i];
+        }
+
+        if(metric == NULL)
+        {
+            if(*metrics_count == *metrics_capacity)
+            {
+                *metrics_capacity = *metrics_capacity == 0 ? 4 : *metrics_capacity * 2;
+                *metrics = realloc(*metrics, *metrics_capacity * sizeof(CbrewBenchmarkMetric));
+            }
+
+            metric = &(*metrics)[(*metrics_count)++];
+            memset(metric, 0, sizeof(CbrewBenchmarkMetric));
+
+            strcpy(metric->name, name);
+            strcpy(metric->unit, unit);
+        }
+
+        if(metric->samples_count == metric->samples_capacity)
+        {
+            metric->samples_capacity = metric->samples_capacity == 0 ? 16 : metric->samples_capacity * 2;
+            metric->samples = realloc(metric->samples, metric->samples_capacity * sizeof(double));
+        }
+
+        metric->samples[metric->samples_count++] = value;
+    }
+}
+
+void cbrew_samples_summarize(double* samples, size_t samples_count, double* median, double* p95, double* stddev)
+{
+    CBREW_ASSERT(samples != NULL);
+    CBREW_ASSERT(samples_count > 0);
+    CBREW_ASSERT(median != NULL);
+    CBREW_ASSERT(p95 != NULL);
+    CBREW_ASSERT(stddev != NULL);
+
+    qsort(samples, samples_count, sizeof(double), cbrew_double_compare);
+
+    *median = samples_count % 2 == 1 ? samples[samples_count / 2] : (samples[samples_count / 2 - 1] + samples[samples_count / 2]) / 2.0;
+
+    // Nearest rank, so the percentile is always one of the samples
+    size_t p95_rank = (95 * samples_count + 99) / 100;
+    *p95 = samples[p95_rank > 0 ? p95_rank - 1 : 0];
+
+    double mean = 0.0;
+    for(size_t i = 0; i < samples_count; ++i)
+        mean += samples[i];
+
+    mean /= (double) samples_count;
+
+    double variance = 0.0;
+    for(size_t i = 0; i < samples_count; ++i)
+        variance += (samples[i] - mean) * (samples[i] - mean);
+
+    *stddev = samples_count > 1 ? cbrew_sqrt(variance / (double) (samples_count - 1)) : 0.0;
+}
+
+CbrewBool cbrew_benchmark_baseline(const char* history, const char* benchmark, const char* metric, double* baseline)
+{
+    CBREW_ASSERT(benchmark != NULL);
+    CBREW_ASSERT(metric != NULL);
+    CBREW_ASSERT(baseline != NULL);
+
+    // The most recent medians are kept inside a ring buffer
+    double medians[CBREW_BENCHMARK_BASELINE_RUNS];
+    size_t medians_count = 0;
+
+    for(const char* line = history; line != NULL && *line != '\0'; line = strchr(line, '\n'), line = line == NULL ? NULL : line + 1)
+    {
+        unsigned long long time = 0;
+        double median = 0.0;
+        double p95 = 0.0;
+        double stddev = 0.0;
+        size_t samples_count = 0;
+        char name[64] = { 0 };
+        char unit[16] = { 0 };
+        int filepath_offset = 0;
+
+        if(sscanf(line, "%llu %lf %lf %lf %zu %63s %15s %n", &time, &median, &p95, &stddev, &samples_count, name, unit, &filepath_offset) < 7 || filepath_offset == 0)
+            continue;
+
+        const char* filepath = line + filepath_offset;
+        const size_t benchmark_len = strlen(benchmark);
+
+        if(strcmp(name, metric) != 0 || strncmp(filepath, benchmark, benchmark_len) != 0 || (filepath[benchmark_len] != '\n' && filepath[benchmark_len] != '\r' && filepath[benchmark_len] != '\0'))
+            continue;
+
+        medians[medians_count++ % CBREW_BENCHMARK_BASELINE_RUNS] = median;
+    }
+
+    if(medians_count == 0)
+        return CBREW_FALSE;
+
+    if(medians_count > CBREW_BENCHMARK_BASELINE_RUNS)
+        medians_count = CBREW_BENCHMARK_BASELINE_RUNS;
+
+    double p95 = 0.0;
+    double stddev = 0.0;
+    cbrew_samples_summarize(medians, medians_count, baseline, &p95, &stddev);
+
+    return CBREW_TRUE;
+}
+
+int cbrew_double_compare(const void* a, const void* b)
+{
+    CBREW_ASSERT(a != NULL);
+    CBREW_ASSERT(b != NULL);
+
+    const double lhs = *(const double*) a;
+    const double rhs = *(const double*) b;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+double cbrew_sqrt(double value)
+{
+    CBREW_ASSERT(value >= 0.0);
+
+    if(value == 0.0)
+        return 0.0;
+
+    // Newton's method, starting above the root
+    double root = value > 1.0 ? value : 1.0;
+
+    // The estimates only decrease until they can't get any closer
+    while(CBREW_TRUE)
+    {
+        const double next = (root + value / root) / 2.0;
+
+        if(next >= root)
+            break;
+
+        root = next;
+    }
+
+    return root;
+}
+
+/* Statistics */
+
+CbrewBool cbrew_stats_parse_record(char* line, CbrewStatsRecord* record)
+{
+    CBREW_ASSERT(line != NULL);
+    CBREW_ASSERT(record != NULL);
+
+    memset(record, 0, sizeof(CbrewStatsRecord));
+
+    unsigned long long time = 0;
+    int success = 0;
+    int configs_offset = 0;
+
+    if(sscanf(line, "%llu %d %lf %zu %zu %zu %zu %zu %zu %n", &time, &success, &record->wall_time, &record->actions_count, &record->run_count,
+        &record->up_to_date_count, &record->failed_count, &record->skipped_count, &record->peak_memory_kb, &configs_offset) < 9 || configs_offset == 0)
+        return CBREW_FALSE;
+
+    record->time = time;
+    record->success = success != 0;
+    record->configs = line + configs_offset;
+    record->selection = "*";
+
+    char* separator = strchr(line + configs_offset, ' ');
+    if(separator != NULL)
+    {
+        *separator = '\0';
+        record->selection = separator + 1;
+    }
+
+    return CBREW_TRUE;
+}
+
+CbrewBool cbrew_stats_report(size_t records_count)
+{
+    char* stats = cbrew_file_read(CBREW_STATS_FILEPATH, NULL);
+    if(stats == NULL)
+    {
+        CBREW_LOG_WARN("No builds have been recorded in %s yet!", CBREW_STATS_FILEPATH);
+        return CBREW_FALSE;
+    }
+
+    size_t lines_count = 1;
+    for(const char* c = stats; *c != '\0'; ++c)
+    {
+        if(*c == '\n')
+            ++lines_count;
+    }
+
+    CbrewStatsRecord* records = malloc(lines_count * sizeof(CbrewStatsRecord));
+    size_t parsed_count = 0;
+
+    for(char* line = strtok(stats, "\r\n"); line != NULL; line = strtok(NULL, "\r\n"))
+    {
+        if(cbrew_stats_parse_record(line, &records[parsed_count]))
+            ++parsed_count;
+    }
+
+    double* trailing = malloc(CBREW_STATS_TRAILING_RECORDS * sizeof(double));
+    double* wall_times = malloc((parsed_count + 1) * sizeof(double));
+    size_t wall_times_count = 0;
+
+    size_t slow_count = 0;
+
+    for(size_t i = parsed_count > records_count ? parsed_count - records_count : 0; i < parsed_count; ++i)
+    {
+        const CbrewStatsRecord* record = &records[i];
+
+        // Builds that ran nothing measure finding files and checking them, every other build mostly measures its actions
+        const CbrewBool no_op = record->run_count == 0;
+        const double cost = no_op ? record->wall_time : record->wall_time / (double) record->run_count;
+
+        size_t trailing_count = 0;
+
+        for(size_t j = i; j > 0 && trailing_count < CBREW_STATS_TRAILING_RECORDS; --j)
+        {
+            const CbrewStatsRecord* previous = &records[j - 1];
+
+            if(!previous->success || (previous->run_count == 0) != no_op || strcmp(previous->selection, record->selection) != 0)
+                continue;
+
+            trailing[trailing_count++] = no_op ? previous->wall_time : previous->wall_time / (double) previous->run_count;
+        }
+
+        double median = 0.0;
+        double p95 = 0.0;
+        double stddev = 0.0;
+
+        if(trailing_count > 0)
+            cbrew_samples_summarize(trailing, trailing_count, &median, &p95, &stddev);
+
+        const time_t record_time = (time_t) record->time;
+        char date[32] = "?";
+        const struct tm* local_time = localtime(&record_time);
+        if(local_time != NULL)
+            strftime(date, sizeof(date), "%Y-%m-%d %H:%M", local_time);
+
+        const size_t checked_count = record->run_count + record->up_to_date_count;
+        const double hit_rate = checked_count > 0 ? 100.0 * (double) record->up_to_date_count / (double) checked_count : 0.0;
+
+        char summary[512];
+        snprintf(summary, sizeof(summary), "%s %8.0lfms  %zu run, %zu up to date (%.0lf%% cached), %zu failed, %zu skipped, peak %zuMB%s%s",
+            date, record->wall_time, record->run_count, record->up_to_date_count, hit_rate, record->failed_count, record->skipped_count, record->peak_memory_kb / 1024,
+            strcmp(record->selection, "*") != 0 ? ", targets " : "", strcmp(record->selection, "*") != 0 ? record->selection : "");
+
+        // A few builds are needed before a median means anything
+        if(record->success && trailing_count >= 3 && median > 0.0 && cost > median * CBREW_STATS_SLOW_FACTOR)
+        {
+            CBREW_LOG_WARN("%s  %.0lf%% slower than the median of %zu previous builds", summary, (cost / median - 1.0) * 100.0, trailing_count);
+            ++slow_count;
+        }
+        else if(!record->success)
+            CBREW_LOG_ERROR("%s  failed", summary);
+        else
+            CBREW_LOG_INFO("%s", summary);
+
+        // Configs are stored as Project:Config=ms, separated by commas
+        if(strcmp(record->configs, "-") != 0)
+        {
+            CbrewStringBuilder configs;
+            memset(&configs, 0, sizeof(CbrewStringBuilder));
+
+            for(const char* c = record->configs; *c != '\0'; ++c)
+            {
+                if(*c == '=')
+                    cbrew_string_builder_append(&configs, " ");
+                else if(*c == ',')
+                    cbrew_string_builder_append(&configs, "ms, ");
+                else
+                    cbrew_string_builder_append_format(&configs, "%c", *c);
+            }
+
+            CBREW_LOG_INFO("    %sms", configs.data);
+
+            cbrew_string_builder_free(&configs);
+        }
+
+        if(record->success)
+            wall_times[wall_times_count++] = record->wall_time;
+    }
+
+    if(wall_times_count > 0)
+    {
+        double median = 0.0;
+        double p95 = 0.0;
+        double stddev = 0.0;
+        cbrew_samples_summarize(wall_times, wall_times_count, &median, &p95, &stddev);
+
+        CBREW_LOG_INFO("Successful builds took %s%.0lfms%s in the median and %s%.0lfms%s in the 95th percentile, %zu of them were significantly slower than usual",
+            CBREW_CONSOLE_COLOR_TIME, median, CBREW_CONSOLE_COLOR_INFO, CBREW_CONSOLE_COLOR_TIME, p95, CBREW_CONSOLE_COLOR_INFO, slow_count);
+    }
+
+    free(wall_times);
+    free(trailing);
+    free(records);
+    free(stats);
+
+    return parsed_count > 0;
+}
+
+/* Jobserver */
+
+CbrewBool cbrew_jobserver_acquire(CbrewJobserver* jobserver, int timeout_ms)
+{
+    CBREW_ASSERT(jobserver != NULL);
+
+    if(!jobserver->active)
+        return CBREW_FALSE;
+
+    char token = '+';
+    if(!cbrew_jobserver_read_token(jobserver, timeout_ms, &token))
+        return CBREW_FALSE;
+
+    if(jobserver->tokens_count == jobserver->tokens_capacity)
+    {
+        jobserver->tokens_capacity = jobserver->tokens_capacity == 0 ? 16 : jobserver->tokens_capacity * 2;
+        jobserver->tokens = realloc(jobserver->tokens, jobserver->tokens_capacity * sizeof(char));
+    }
+
+    jobserver->tokens[jobserver->tokens_count++] = token;
+
+    return CBREW_TRUE;
+}
+
+void cbrew_jobserver_release(CbrewJobserver* jobserver)
+{
+    CBREW_ASSERT(jobserver != NULL);
+
+    if(!jobserver->active || jobserver->tokens_count == 0)
+        return;
+
+    // The token must be returned unchanged, as make encodes information in it
+    cbrew_jobserver_write_token(jobserver, jobserver->tokens[--jobserver->tokens_count]);
+}
+
+/* History */
+
+void cbrew_history_load(CbrewHistory* history, const char* filepath)
+{
+    CBREW_ASSERT(history != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    FILE* f = fopen(filepath, "r");
+    if(f == NULL)
+        return;
+
+    char line[CBREW_FILEPATH_MAX + 64];
+    while(fgets(line, sizeof(line), f) != NULL)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+
+        // Every line consists of the peak memory usage, the duration, the command signature and the key
+        char* key = line;
+        const size_t peak_memory_kb = strtoull(key, &key, 10);
+        const double duration = strtod(key, &key);
+        const uint64_t signature = strtoull(key, &key, 16);
+
+        if(key == line || *key != ' ')
+            continue;
+
+        CbrewHistoryEntry* entry = cbrew_history_get(history, key + 1, CBREW_TRUE);
+        entry->peak_memory_kb = peak_memory_kb;
+        entry->duration = duration;
+        entry->signature = signature;
+    }
+
+    fclose(f);
+}
+
+CbrewBool cbrew_history_save(const CbrewHistory* history, const char* filepath)
+{
+    CBREW_ASSERT(history != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    // The history is replaced at once, so an interrupted build never leaves a truncated file behind
+    char tmp_filepath[CBREW_FILEPATH_MAX];
+    sprintf(tmp_filepath, "%s.tmp", filepath);
+
+    FILE* f = fopen(tmp_filepath, "w");
+    if(f == NULL)
+        return CBREW_FALSE;
+
+    for(size_t i = 0; i < history->entries_capacity; ++i)
+    {
+        const CbrewHistoryEntry* entry = &history->entries[i];
+
+        if(entry->key != NULL)
+            fprintf(f, "%zu %.0lf %016llx %s\n", entry->peak_memory_kb, entry->duration, (unsigned long long) entry->signature, entry->key);
+    }
+
+    if(fclose(f) != 0)
+    {
+        cbrew_file_delete(tmp_filepath);
+        return CBREW_FALSE;
+    }
+
+    return cbrew_file_rename(tmp_filepath, filepath);
+}
+
+CbrewHistoryEntry* cbrew_history_get(CbrewHistory* history, const char* key, CbrewBool create)
+{
+    CBREW_ASSERT(history != NULL);
+    CBREW_ASSERT(key != NULL);
+
+    if(history->entries_capacity > 0)
+    {
+        size_t index = cbrew_hash_str(key) & (history->entries_capacity - 1);
+        while(history->entries[index].key != NULL)
+        {
+            if(strcmp(history->entries[index].key, key) == 0)
+                return &history->entries[index];
+
+            index = (index + 1) & (history->entries_capacity - 1);
+        }
+    }
+
+    if(!create)
+        return NULL;
+
+    // Open addressing hash table, which is kept at most half full
+    if((history->entries_count + 1) * 2 > history->entries_capacity)
+    {
+        const size_t new_capacity = history->entries_capacity == 0 ? 256 : history->entries_capacity * 2;
+        CbrewHistoryEntry* new_entries = calloc(new_capacity, sizeof(CbrewHistoryEntry));
+
+        for(size_t i = 0; i < history->entries_capacity; ++i)
+        {
+            const CbrewHistoryEntry* entry = &history->entries[i];
+
+            if(entry->key == NULL)
+                continue;
+
+            size_t index = cbrew_hash_str(entry->key) & (new_capacity - 1);
+            while(new_entries[index].key != NULL)
+                index = (index + 1) & (new_capacity - 1);
+
+            new_entries[index] = *entry;
+        }
+
+        free(history->entries);
+
+        history->entries = new_entries;
+        history->entries_capacity = new_capacity;
+    }
+
+    size_t index = cbrew_hash_str(key) & (history->entries_capacity - 1);
+    while(history->entries[index].key != NULL)
+        index = (index + 1) & (history->entries_capacity - 1);
+
+    CbrewHistoryEntry* entry = &history->entries[index];
+    memset(entry, 0, sizeof(CbrewHistoryEntry));
+    entry->key = strdup(key);
+
+    ++history->entries_count;
+
+    return entry;
+}
+
+void cbrew_history_free(CbrewHistory* history)
+{
+    CBREW_ASSERT(history != NULL);
+
+    for(size_t i = 0; i < history->entries_capacity; ++i)
+        free(history->entries[i].key);
+
+    free(history->entries);
+
+    memset(history, 0, sizeof(CbrewHistory));
+}
+
+/* Include cache */
+
+void cbrew_include_cache_load(CbrewIncludeCache* cache, const char* filepath)
+{
+    CBREW_ASSERT(cache != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    char* content = cbrew_file_read(filepath, NULL);
+    if(content == NULL)
+        return;
+
+    // Every file starts with a line consisting of its modification time and its path, followed by one indented line per directive
+    CbrewIncludeCacheEntry* entry = NULL;
+    CbrewStringBuilder includes;
+    memset(&includes, 0, sizeof(CbrewStringBuilder));
+
+    for(char* line = strtok(content, "\r\n"); line != NULL; line = strtok(NULL, "\r\n"))
+    {
+        if(line[0] == '\t')
+        {
+            if(entry != NULL)
+                cbrew_string_builder_append_format(&includes, "%s\n", line + 1);
+
+            continue;
+        }
+
+        if(entry != NULL)
+            entry->includes = cbrew_string_builder_release(&includes);
+
+        char* key = line;
+        const uint64_t mtime = strtoull(key, &key, 10);
+
+        if(key == line || *key != ' ')
+        {
+            entry = NULL;
+            continue;
+        }
+
+        entry = cbrew_include_cache_get(cache, key + 1, CBREW_TRUE);
+        entry->mtime = mtime;
+
+        free(entry->includes);
+        entry->includes = NULL;
+    }
+
+    if(entry != NULL)
+        entry->includes = cbrew_string_builder_release(&includes);
+
+    cbrew_string_builder_free(&includes);
+
+    free(content);
+}
+
+CbrewBool cbrew_include_cache_save(const CbrewIncludeCache* cache, const char* filepath)
+{
+    CBREW_ASSERT(cache != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    // The cache is replaced at once, so an interrupted build never leaves a truncated file behind
+    char tmp_filepath[CBREW_FILEPATH_MAX];
+    sprintf(tmp_filepath, "%s.tmp", filepath);
+
+    FILE* f = fopen(tmp_filepath, "w");
+    if(f == NULL)
+        return CBREW_FALSE;
+
+    for(size_t i = 0; i < cache->entries_capacity; ++i)
+    {
+        const CbrewIncludeCacheEntry* entry = &cache->entries[i];
+
+        if(entry->key == NULL || entry->includes == NULL)
+            continue;
+
+        fprintf(f, "%llu %s\n", (unsigned long long) entry->mtime, entry->key);
+
+        for(const char* include = entry->includes; *include != '\0';)
+        {
+            const char* include_end = strchr(include, '\n');
+            const size_t include_len = include_end == NULL ? strlen(include) : (size_t) (include_end - include);
+
+            fprintf(f, "\t%.*s\n", (int) include_len, include);
+
+            include = include_end == NULL ? include + include_len : include_end + 1;
+        }
+    }
+
+    if(fclose(f) != 0)
+    {
+        cbrew_file_delete(tmp_filepath);
+        return CBREW_FALSE;
+    }
+
+    return cbrew_file_rename(tmp_filepath, filepath);
+}
+
+CbrewIncludeCacheEntry* cbrew_include_cache_get(CbrewIncludeCache* cache, const char* key, CbrewBool create)
+{
+    CBREW_ASSERT(cache != NULL);
+    CBREW_ASSERT(key != NULL);
+
+    if(cache->entries_capacity > 0)
+    {
+        size_t index = cbrew_hash_str(key) & (cache->entries_capacity - 1);
+        while(cache->entries[index].key != NULL)
+        {
+            if(strcmp(cache->entries[index].key, key) == 0)
+                return &cache->entries[index];
+
+            index = (index + 1) & (cache->entries_capacity - 1);
+        }
+    }
+
+    if(!create)
+        return NULL;
+
+    // Open addressing hash table, which is kept at most half full
+    if((cache->entries_count + 1) * 2 > cache->entries_capacity)
+    {
+        const size_t new_capacity = cache->entries_capacity == 0 ? 256 : cache->entries_capacity * 2;
+        CbrewIncludeCacheEntry* new_entries = calloc(new_capacity, sizeof(CbrewIncludeCacheEntry));
+
+        for(size_t i = 0; i < cache->entries_capacity; ++i)
+        {
+            const CbrewIncludeCacheEntry* entry = &cache->entries[i];
+
+            if(entry->key == NULL)
+                continue;
+
+            size_t index = cbrew_hash_str(entry->key) & (new_capacity - 1);
+            while(new_entries[index].key != NULL)
+                index = (index + 1) & (new_capacity - 1);
+
+            new_entries[index] = *entry;
+        }
+
+        free(cache->entries);
+
+        cache->entries = new_entries;
+        cache->entries_capacity = new_capacity;
+    }
+
+    size_t index = cbrew_hash_str(key) & (cache->entries_capacity - 1);
+    while(cache->entries[index].key != NULL)
+        index = (index + 1) & (cache->entries_capacity - 1);
+
+    CbrewIncludeCacheEntry* entry = &cache->entries[index];
+    memset(entry, 0, sizeof(CbrewIncludeCacheEntry));
+    entry->key = strdup(key);
+
+    ++cache->entries_count;
+
+    return entry;
+}
+
+const char* cbrew_include_cache_scan(CbrewIncludeCache* cache, const char* filepath)
+{
+    CBREW_ASSERT(cache != NULL);
+    CBREW_ASSERT(filepath != NULL);
+
+    const uint64_t mtime = cbrew_file_mtime(filepath);
+    if(mtime == 0)
+        return NULL;
+
+    CbrewIncludeCacheEntry* entry = cbrew_include_cache_get(cache, filepath, CBREW_TRUE);
+
+    if(entry->includes != NULL && entry->mtime == mtime)
+        return entry->includes;
+
+    free(entry->includes);
+
+    entry->includes = cbrew_file_scan_includes(filepath);
+    entry->mtime = mtime;
+
+    return entry->includes;
+}
+
+void cbrew_include_cache_free(CbrewIncludeCache* cache)
+{
+    CBREW_ASSERT(cache != NULL);
+
+    for(size_t i = 0; i < cache->entries_capacity; ++i)
+    {
+        free(cache->entries[i].key);
+        free(cache->entries[i].includes);
+    }
+
+    free(cache->entries);
+
+    memset(cache, 0, sizeof(CbrewIncludeCache));
+}
+
+/* Memory */
+
+void* cbrew_arena_alloc(CbrewArena* arena, size_t size)
+{
+    CBREW_ASSERT(arena != NULL);
+
+    // Blocks store their header in front of their data, which must stay aligned
+    const size_t header_size = (sizeof(CbrewArenaBlock) + CBREW_ARENA_ALIGNMENT - 1) & ~((size_t) CBREW_ARENA_ALIGNMENT - 1);
+
+    size = (size + CBREW_ARENA_ALIGNMENT - 1) & ~((size_t) CBREW_ARENA_ALIGNMENT - 1);
+
+    CbrewArenaBlock* block = arena->blocks;
+
+    if(block == NULL || block->size - block->used < size)
+    {
+        const size_t block_size = size > CBREW_ARENA_BLOCK_SIZE ? size : CBREW_ARENA_BLOCK_SIZE;
+
+        block = malloc(header_size + block_size);
+
+        if(block == NULL)
+        {
+            CBREW_LOG_ERROR("Failed to allocate %zu bytes!", header_size + block_size);
+            exit(EXIT_FAILURE);
+        }
+
+        block->size = block_size;
+        block->used = 0;
+
+        // Oversized blocks are filled completely, so keep allocating from the current block
+        if(arena->blocks != NULL && block_size > CBREW_ARENA_BLOCK_SIZE)
+        {
+            block->next = arena->blocks->next;
+            arena->blocks->next = block;
+        }
+        else
+        {
+            block->next = arena->blocks;
+            arena->blocks = block;
+        }
+    }
+
+    void* memory = (char*) block + header_size + block->used;
+    block->used += size;
+
+    memset(memory, 0, size);
+
+    return memory;
+}
+
+char* cbrew_arena_strdup(CbrewArena* arena, const char* str)
+{
+    CBREW_ASSERT(arena != NULL);
+    CBREW_ASSERT(str != NULL);
+
+    const size_t len = strlen(str);
+
+    char* copy = cbrew_arena_alloc(arena, len + 1);
+    memcpy(copy, str, len + 1);
+
+    return copy;
+}
+
+void* cbrew_arena_array_grow(CbrewArena* arena, void* array, size_t count, size_t* capacity, size_t element_size)
+{
+    CBREW_ASSERT(arena != NULL);
+    CBREW_ASSERT(capacity != NULL);
+    CBREW_ASSERT(count <= *capacity);
+
+    if(array != NULL && count < *capacity)
+        return array;
+
+    const size_t new_capacity = *capacity == 0 ? 8 : *capacity * 2;
+
+    void* new_array = cbrew_arena_alloc(arena, new_capacity * element_size);
+
+    if(array != NULL)
+        memcpy(new_array, array, count * element_size);
+
+    *capacity = new_capacity;
+
+    return new_array;
+}
+
+void cbrew_arena_free(CbrewArena* arena)
+{
+    CBREW_ASSERT(arena != NULL);
+
+    CbrewArenaBlock* block = arena->blocks;
+
+    while(block != NULL)
+    {
+        CbrewArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->blocks = NULL;
+}
+
+const char* cbrew_intern(const char* str)
+{
+    CBREW_ASSERT(str != NULL);
+
+    // Open addressing hash table, which is kept at most half full
+    if((handler.strings_count + 1) * 2 > handler.strings_capacity)
+    {
+        const size_t new_capacity = handler.strings_capacity == 0 ? 256 : handler.strings_capacity * 2;
+        const char** new_strings = calloc(new_capacity, sizeof(char*));
+
+        for(size_t i = 0; i < handler.strings_capacity; ++i)
+        {
+            const char* string = handler.strings[i];
+
+            if(string == NULL)
+                continue;
+
+            size_t index = cbrew_hash_str(string) & (new_capacity - 1);
+            while(new_strings[index] != NULL)
+                index = (index + 1) & (new_capacity - 1);
+
+            new_strings[index] = string;
+        }
+
+        free(handler.strings);
+
+        handler.strings = new_strings;
+        handler.strings_capacity = new_capacity;
+    }
+
+    size_t index = cbrew_hash_str(str) & (handler.strings_capacity - 1);
+    while(handler.strings[index] != NULL)
+    {
+        if(strcmp(handler.strings[index], str) == 0)
+            return handler.strings[index];
+
+        index = (index + 1) & (handler.strings_capacity - 1);
+    }
+
+    handler.strings[index] = cbrew_arena_strdup(&handler.arena, str);
+    ++handler.strings_count;
+
+    return handler.strings[index];
+}
+
+const char* cbrew_intern_path(const char* path)
+{
+    CBREW_ASSERT(path != NULL);
+
+    char* converted_path = cbrew_path(strdup(path));
+
+    const char* interned_path = cbrew_intern(converted_path);
+
+    free(converted_path);
+
+    return interned_path;
+}
+
+/* String builder */
+
+void cbrew_string_builder_reserve(CbrewStringBuilder* sb, size_t len)
+{
+    CBREW_ASSERT(sb != NULL);
+
+    if(sb->len + len + 1 <= sb->capacity)
+        return;
+
+    size_t new_capacity = sb->capacity == 0 ? 256 : sb->capacity;
+    while(sb->len + len + 1 > new_capacity)
+        new_capacity *= 2;
+
+    sb->data = realloc(sb->data, new_capacity);
+    sb->capacity = new_capacity;
+}
+
+void cbrew_string_builder_append(CbrewStringBuilder* sb, const char* str)
+{
+    CBREW_ASSERT(sb != NULL);
+    CBREW_ASSERT(str != NULL);
+
+    const size_t len = strlen(str);
+
+    cbrew_string_builder_reserve(sb, len);
+
+    memcpy(sb->data + sb->len, str, len + 1);
+    sb->len += len;
+}
+
+void cbrew_string_builder_append_format(CbrewStringBuilder* sb, const char* format, ...)
+{
+    CBREW_ASSERT(sb != NULL);
+    CBREW_ASSERT(format != NULL);
+
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+
+    if(len <= 0)
+        return;
+
+    cbrew_string_builder_reserve(sb, len);
+
+    va_start(args, format);
+    vsnprintf(sb->data + sb->len, len + 1, format, args);
+    va_end(args);
+
+    sb->len += len;
+}
+
+void cbrew_string_builder_append_argument(CbrewStringBuilder* sb, const char* arg)
+{
+    CBREW_ASSERT(sb != NULL);
+    CBREW_ASSERT(arg != NULL);
+
+#ifdef CBREW_PLATFORM_WINDOWS
+    // Backslashes are only special in front of quotes, where they have to be doubled
+    cbrew_string_builder_append(sb, "\"");
+
+    size_t backslashes_count = 0;
+    for(const char* c = arg; *c != '\0'; ++c)
+    {
+        if(*c == '\\')
+        {
+            ++backslashes_count;
+            continue;
+        }
+
+        const size_t repeat_count = *c == '"' ? backslashes_count * 2 + 1 : backslashes_count;
+        for(size_t i = 0; i < repeat_count; ++i)
+            cbrew_string_builder_append(sb, "\\");
+
+        backslashes_count = 0;
+
+        cbrew_string_builder_append_format(sb, "%c", *c);
+    }
+
+    for(size_t i = 0; i < backslashes_count * 2; ++i)
+        cbrew_string_builder_append(sb, "\\");
+
+    cbrew_string_builder_append(sb, "\"");
+#else
+    // Nothing is expanded inside single quotes, so only single quotes themselves have to be closed and escaped
+    cbrew_string_builder_append(sb, "'");
+
+    for(const char* c = arg; *c != '\0'; ++c)
+    {
+        if(*c == '\'')
+            cbrew_string_builder_append(sb, "'\\''");
+        else
+            cbrew_string_builder_append_format(sb, "%c", *c);
+    }
+
+    cbrew_string_builder_append(sb, "'");
+#endif
+}
+
+void cbrew_string_builder_append_flags(CbrewStringBuilder* sb, const char** flags, size_t flags_count)
+{
+    CBREW_ASSERT(sb != NULL);
+
+    for(size_t i = 0; i < flags_count; ++i)
+    {
+        cbrew_string_builder_append(sb, flags[i]);
+        cbrew_string_builder_append(sb, " ");
+    }
+}
+
+void cbrew_string_builder_append_defines(CbrewStringBuilder* sb, const char** defines, size_t defines_count)
+{
+    CBREW_ASSERT(sb != NULL);
+
+    for(size_t i = 0; i < defines_count; ++i)
+    {
+        cbrew_string_builder_append(sb, "-D");
+        cbrew_string_builder_append(sb, defines[i]);
+        cbrew_string_builder_append(sb, " ");
+    }
+}
+
+void cbrew_string_builder_append_include_dirs(CbrewStringBuilder* sb, const char** include_dirs, size_t include_dirs_count)
+{
+    CBREW_ASSERT(sb != NULL);
+
+    for(size_t i = 0; i < include_dirs_count; ++i)
+    {
+        cbrew_string_builder_append(sb, "-I");
+        cbrew_string_builder_append(sb, include_dirs[i]);
+        cbrew_string_builder_append(sb, " ");
+    }
+}
+
+void cbrew_string_builder_append_links(CbrewStringBuilder* sb, const char** links, size_t links_count)
+{
+    CBREW_ASSERT(sb != NULL);
+
+    for(size_t i = 0; i < links_count; ++i)
+    {
+        const char* last_slash = strrchr(links[i], CBREW_PATH_SEPARATOR);
+
+        if(last_slash == NULL)
+            cbrew_string_builder_append_format(sb, "-L. -l%s ", links[i]);
+        else
+            cbrew_string_builder_append_format(sb, "-L%.*s -l%s ", (int) (last_slash - links[i]), links[i], last_slash + 1);
+    }
+}
+
+char* cbrew_string_builder_release(CbrewStringBuilder* sb)
+{
+    CBREW_ASSERT(sb != NULL);
+
+    char* str = sb->data == NULL ? calloc(1, sizeof(char)) : sb->data;
+
+    memset(sb, 0, sizeof(CbrewStringBuilder));
+
+    return str;
+}
+
+void cbrew_string_builder_free(CbrewStringBuilder* sb)
+{
+    CBREW_ASSERT(sb != NULL);
+
+    free(sb->data);
+
+    memset(sb, 0, sizeof(CbrewStringBuilder));
+}
+
+/* Util */
+
+void cbrew_compiler_program(char* program, const char* compiler)
+{
+    CBREW_ASSERT(program != NULL);
+    CBREW_ASSERT(compiler != NULL);
+
+    static const char* launchers[] = { "ccache", "sccache", "distcc", "icecc" };
+
+    program[0] = '\0';
+
+    for(const char* word = compiler + strspn(compiler, " \t"); *word != '\0'; word += strspn(word, " \t"))
+    {
+        const int word_len = (int) strcspn(word, " \t");
+        snprintf(program, CBREW_FILEPATH_MAX, "%.*s", word_len, word);
+
+        word += word_len;
+
+        // Launchers are compared without their directory and extension
+        const char* name = program + strlen(program);
+        while(name > program && name[-1] != '/' && name[-1] != '\\')
+            --name;
+
+        CbrewBool launcher = CBREW_FALSE;
+        for(size_t i = 0; i < sizeof(launchers) / sizeof(launchers[0]) && !launcher; ++i)
+        {
+            const size_t launcher_len = strlen(launchers[i]);
+            launcher = strncmp(name, launchers[i], launcher_len) == 0 && (name[launcher_len] == '\0' || name[launcher_len] == '.');
+        }
+
+        if(!launcher)
+            return;
+    }
+}
+
+CbrewBool cbrew_program_filepath(char* filepath, const char* program)
+{
+    CBREW_ASSERT(filepath != NULL);
+    CBREW_ASSERT(program != NULL);
+
+    if(strchr(program, '/') != NULL || strchr(program, CBREW_PATH_SEPARATOR) != NULL)
+    {
+        strcpy(filepath, program);
+        return cbrew_file_mtime(filepath) != 0;
+    }
+
+#ifdef CBREW_PLATFORM_WINDOWS
+    const char path_list_separator = ';';
+    const char* program_extension = strrchr(program, '.') == NULL ? ".exe" : "";
+#else
+    const char path_list_separator = ':';
+    const char* program_extension = "";
+#endif
+
+    const char* path = getenv("PATH");
+
+    while(path != NULL && *path != '\0')
+    {
+        const char* path_end = strchr(path, path_list_separator);
+        const size_t path_len = path_end == NULL ? strlen(path) : (size_t) (path_end - path);
+
+        if(path_len > 0 && snprintf(filepath, CBREW_FILEPATH_MAX, "%.*s%c%s%s", (int) path_len, path, CBREW_PATH_SEPARATOR, program, program_extension) < CBREW_FILEPATH_MAX && cbrew_file_mtime(filepath) != 0)
+            return CBREW_TRUE;
+
+        path = path_end == NULL ? NULL : path_end + 1;
+    }
+
+    strcpy(filepath, program);
+
+    return CBREW_FALSE;
+}
+
+char* cbrew_create_str(const char* format, ...)
+{
+    CBREW_ASSERT(format != NULL);
+
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+
+    char* str = malloc((len + 1) * sizeof(char));
+
+    va_start(args, format);
+    vsnprintf(str, len + 1, format, args);
+    va_end(args);
+
+    return str;
+}
+
+uint64_t cbrew_hash_str(const char* str)
+{
+    CBREW_ASSERT(str != NULL);
+
+    uint64_t hash = 14695981039346656037ULL;
+
+    for(const char* c = str; *c != '\0'; ++c)
+        hash = (hash ^ (uint8_t) *c) * 1099511628211ULL;
+
+    return hash;
+}
+
+int cbrew_str_compare(const void* a, const void* b)
+{
+    CBREW_ASSERT(a != NULL);
+    CBREW_ASSERT(b != NULL);
+
+    return strcmp(*(const char* const*) a, *(const char* const*) b);
+}
+
+char* cbrew_path(char* path)
+{
+    CBREW_ASSERT(path != NULL);
+
+    for(size_t i = 0; i < strlen(path); ++i)
+    {
+        if(path[i] == '/')
+            path[i] = CBREW_PATH_SEPARATOR;
+    }
+
+    return path;
+}
+
+char* cbrew_create_flags_str(const char** flags, size_t flags_count)
+{
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    cbrew_string_builder_append_flags(&sb, flags, flags_count);
+
+    return cbrew_string_builder_release(&sb);
+}
+
+char* cbrew_create_defines_str(const char** defines, size_t defines_count)
+{
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    cbrew_string_builder_append_defines(&sb, defines, defines_count);
+
+    return cbrew_string_builder_release(&sb);
+}
+
+char* cbrew_create_include_dirs_str(const char** include_dirs, size_t include_dirs_count)
+{
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    cbrew_string_builder_append_include_dirs(&sb, include_dirs, include_dirs_count);
+
+    return cbrew_string_builder_release(&sb);
+}
+
+char* cbrew_create_links_str(const char** links, size_t links_count)
+{
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    cbrew_string_builder_append_links(&sb, links, links_count);
+
+    return cbrew_string_builder_release(&sb);
+}
+
+CbrewBool cbrew_file_install(const char* src_path, const char* dest_path)
+{
+    CBREW_ASSERT(src_path != NULL);
+    CBREW_ASSERT(dest_path != NULL);
+
+    char dest_dir[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(dest_dir, dest_path));
+
+    char* last_path_separator = strrchr(dest_dir, CBREW_PATH_SEPARATOR);
+    if(last_path_separator != NULL)
+    {
+        *last_path_separator = '\0';
+
+        if(!cbrew_dir_exists(dest_dir) && !cbrew_dir_create(dest_dir))
+        {
+            CBREW_LOG_ERROR("Failed to create directory %s!", dest_dir);
+            return CBREW_FALSE;
+        }
+    }
+
+    char tmp_filepath[CBREW_FILEPATH_MAX];
+    snprintf(tmp_filepath, sizeof(tmp_filepath), "%s.tmp", dest_path);
+
+    // A temporary file that has been left behind by an interrupted install would prevent creating the link
+    cbrew_file_delete(tmp_filepath);
+
+    if(!cbrew_file_link(src_path, tmp_filepath) && !cbrew_file_copy(src_path, tmp_filepath))
+        return CBREW_FALSE;
+
+    if(!cbrew_file_rename(tmp_filepath, dest_path))
+    {
+        CBREW_LOG_ERROR("Failed to rename %s to %s!", tmp_filepath, dest_path);
+        cbrew_file_delete(tmp_filepath);
+        return CBREW_FALSE;
     }
 
-    if(files_count != NULL)
-        *files_count = source_files_count;
+    return CBREW_TRUE;
+}
 
-    if(source_files_count == 0)
+/* IO */
+
+char* cbrew_file_read(const char* filepath, size_t* size)
+{
+    CBREW_ASSERT(filepath != NULL);
+
+    FILE* f = fopen(filepath, "rb");
+    if(f == NULL)
+        return NULL;
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    char buffer[4096];
+    size_t read = 0;
+    while((read = fread(buffer, sizeof(char), sizeof(buffer), f)) > 0)
     {
-        for(size_t i = 0; i < files_found_count; ++i)
-            free(files_found[i]);
+        cbrew_string_builder_reserve(&sb, read);
+        memcpy(sb.data + sb.len, buffer, read);
+        sb.len += read;
+        sb.data[sb.len] = '\0';
+    }
 
-        free(files_found);
+    const CbrewBool failed = ferror(f) != 0;
+    fclose(f);
 
+    if(failed)
+    {
+        cbrew_string_builder_free(&sb);
         return NULL;
     }
 
-    char** source_files = malloc(source_files_count * sizeof(char*));
+    if(size != NULL)
+        *size = sb.len;
 
-    size_t source_file_index = 0;
-    for(size_t i = 0; i < files_found_count; ++i)
+    return cbrew_string_builder_release(&sb);
+}
+
+CbrewBool cbrew_file_is_newer_than_rule(const char* filepath, char* rule, char* newer_prerequisite)
+{
+    CBREW_ASSERT(filepath != NULL);
+    CBREW_ASSERT(rule != NULL);
+
+    const uint64_t file_mtime = cbrew_file_mtime(filepath);
+    if(file_mtime == 0)
+        return CBREW_FALSE;
+
+    // The rule spans multiple lines for many prerequisites, which are joined by a trailing backslash
+    for(char* c = rule; *c != '\0'; ++c)
     {
-        if(cbrew_project_file_matches_wildcards(project, files_found[i]))
-            source_files[source_file_index++] = files_found[i];
+        if(c[0] == '\\' && (c[1] == '\n' || (c[1] == '\r' && c[2] == '\n')))
+            c[0] = ' ';
+    }
+
+    // The first token is the target of the rule
+    char* prerequisite = strtok(rule, " \r\n");
+    while((prerequisite = strtok(NULL, " \r\n")) != NULL)
+    {
+        cbrew_path(prerequisite);
+
+        if(cbrew_file_mtime(prerequisite) > file_mtime)
+        {
+            if(newer_prerequisite != NULL)
+                strcpy(newer_prerequisite, prerequisite);
+
+            return CBREW_FALSE;
+        }
+    }
+
+    return CBREW_TRUE;
+}
+
+char* cbrew_file_scan_includes(const char* filepath)
+{
+    CBREW_ASSERT(filepath != NULL);
+
+    char* source = cbrew_file_read(filepath, NULL);
+    if(source == NULL)
+        return NULL;
+
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    // Directives must be the first token of a line, although comments and whitespace may precede them
+    CbrewBool line_start = CBREW_TRUE;
+
+    for(const char* c = source; *c != '\0';)
+    {
+        if(c[0] == '/' && c[1] == '*')
+        {
+            const char* comment_end = strstr(c + 2, "*/");
+            c = comment_end == NULL ? c + strlen(c) : comment_end + 2;
+        }
+        else if(c[0] == '/' && c[1] == '/')
+        {
+            while(*c != '\0' && *c != '\n')
+                ++c;
+        }
+        else if(c[0] == '\\' && (c[1] == '\n' || (c[1] == '\r' && c[2] == '\n')))
+            c += c[1] == '\n' ? 2 : 3;
+        else if(*c == '\n')
+        {
+            line_start = CBREW_TRUE;
+            ++c;
+        }
+        else if(isspace((unsigned char) *c))
+            ++c;
+        else if(*c == '#' && line_start)
+        {
+            line_start = CBREW_FALSE;
+
+            do
+                ++c;
+            while(*c == ' ' || *c == '\t');
+
+            if(strncmp(c, "include", 7) != 0)
+                continue;
+
+            c += 7;
+
+            if(strncmp(c, "_next", 5) == 0)
+                c += 5;
+
+            while(*c == ' ' || *c == '\t')
+                ++c;
+
+            if(*c != '"' && *c != '<')
+                continue;
+
+            const char closing = *c == '"' ? '"' : '>';
+            const char* include_end = c + 1;
+
+            while(*include_end != '\0' && *include_end != closing && *include_end != '\n')
+                ++include_end;
+
+            if(*include_end == closing)
+            {
+                cbrew_string_builder_append_format(&sb, "%.*s\n", (int) (include_end - c + 1), c);
+                c = include_end + 1;
+            }
+        }
+        else if(*c == '"' || *c == '\'')
+        {
+            // Literals may contain anything that looks like a comment
+            const char quote = *c++;
+
+            while(*c != '\0' && *c != quote && *c != '\n')
+                c += c[0] == '\\' && c[1] != '\0' ? 2 : 1;
+
+            if(*c == quote)
+                ++c;
+
+            line_start = CBREW_FALSE;
+        }
         else
-            free(files_found[i]);
+        {
+            line_start = CBREW_FALSE;
+            ++c;
+        }
     }
 
-    free(files_found);
+    free(source);
 
-    return source_files;
+    return cbrew_string_builder_release(&sb);
 }
 
-CbrewBool cbrew_project_build(const CbrewProject* project)
+CbrewBool cbrew_command(const char* format, ...)
 {
-    CBREW_ASSERT(project != NULL);
+    CBREW_ASSERT(format != NULL);
 
-    const clock_t project_start = clock();
+    char cmd[CBREW_COMMAND_LENGTH_MAX];
 
-    CBREW_LOG_TRACE("Building project %s%s%s...", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_TRACE);
+    va_list args;
+    va_start(args, format);
+    vsprintf(cmd, format, args);
+    va_end(args);
 
-    if(project->configs_count == 0)
+    CBREW_LOG_CMD(cmd);
+
+    CbrewBool result = system(cmd) == EXIT_SUCCESS;
+
+    return result;
+}
+
+CbrewBool cbrew_file_exists(const char* file)
+{
+    CBREW_ASSERT(file != NULL);
+
+    FILE* f = fopen(file, "r");
+
+    if(f == NULL)
+        return CBREW_FALSE;
+
+    fclose(f);
+
+    return CBREW_TRUE;
+}
+
+CbrewBool cbrew_file_delete(const char* file)
+{
+    CBREW_ASSERT(file != NULL);
+
+    return remove(file) == 0;
+}
+
+void cbrew_wildcard_directory(char* dir, const char* wildcard)
+{
+    CBREW_ASSERT(dir != NULL);
+    CBREW_ASSERT(wildcard != NULL);
+
+    cbrew_path(strcpy(dir, wildcard));
+
+    for(size_t i = 0; i < strlen(dir); ++i)
     {
-        CBREW_LOG_WARN("Project %s%s %shas no configs!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
-        CBREW_LOG_WARN("Skipping project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
-        return CBREW_TRUE;
+        if(dir[i] == '?' || dir[i] == '*' || dir[i] == '[')
+        {
+            dir[i] = '\0';
+            break;
+        }
     }
 
-    size_t project_files_count = 0;
-    char** project_files = cbrew_project_find_source_files(project, &project_files_count);
+    char* last_path_separator = strrchr(dir, CBREW_PATH_SEPARATOR);
 
-    if(project_files_count == 0)
+    if(last_path_separator != NULL)
+        *last_path_separator = '\0';
+    else
+        strcpy(dir, ".");
+}
+
+CbrewBool cbrew_wildcard_find_newer_file(const char* wildcard, uint64_t mtime, char* newer_filepath)
+{
+    CBREW_ASSERT(wildcard != NULL);
+    CBREW_ASSERT(newer_filepath != NULL);
+
+    // Plain filepaths don't need their directory to be searched
+    if(strpbrk(wildcard, "?*[") == NULL)
     {
-        CBREW_LOG_WARN("Project %s%s %shas no source files!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
-        CBREW_LOG_WARN("Skipping project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+        if(cbrew_file_mtime(wildcard) <= mtime)
+            return CBREW_FALSE;
+
+        strcpy(newer_filepath, wildcard);
         return CBREW_TRUE;
     }
 
-    if(project->type >= CBREW_PROJECT_TYPE_SIZE)
-    {
-        CBREW_LOG_WARN("Invalid project type specified for project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
-        CBREW_LOG_WARN("Skipping project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
+    char dir[CBREW_FILEPATH_MAX];
+    cbrew_wildcard_directory(dir, wildcard);
 
-        for(size_t i = 0; i < project_files_count; ++i)
-            free(project_files[i]);
+    size_t files_count = 0;
+    char** files = cbrew_find_files_recursive(dir, &files_count);
 
-        free(project_files);
+    CbrewBool found = CBREW_FALSE;
 
-        return CBREW_FALSE;
+    for(size_t i = 0; i < files_count; ++i)
+    {
+        if(!found && cbrew_file_matches_wildcard(files[i], wildcard) && cbrew_file_mtime(files[i]) > mtime)
+        {
+            strcpy(newer_filepath, files[i]);
+            found = CBREW_TRUE;
+        }
+
+        free(files[i]);
     }
 
-    CbrewBool project_success = CBREW_TRUE;
+    free(files);
 
-    for(size_t i = 0; i < project->configs_count; ++i)
-    {
-        CbrewConfig* config = &project->configs[i];
+    return found;
+}
+
+CbrewBool cbrew_file_matches_wildcard(const char* filepath, const char* wildcard)
+{
+    CBREW_ASSERT(filepath != NULL);
+    CBREW_ASSERT(wildcard != NULL);
+
+    char filepath_pathed[CBREW_FILEPATH_MAX];
+    char wildcard_pathed[CBREW_FILEPATH_MAX];
+
+    cbrew_path(strcpy(filepath_pathed, filepath));
+    cbrew_path(strcpy(wildcard_pathed, wildcard));
+
+    const char* fp = filepath_pathed;
+    const char* wc = wildcard_pathed;
 
-        const clock_t config_start = clock();
+    if (*wc == '\0' && *fp == '\0')
+        return CBREW_TRUE;
 
-        CBREW_LOG_TRACE("Building config %s%s%s...", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_TRACE);
+    if (*wc == '*' && *(wc + 1) != '\0' && *fp == '\0')
+        return CBREW_FALSE;
 
-        CbrewBool config_success = CBREW_TRUE;
+    if (*wc == '?' || *wc == *fp)
+        return cbrew_file_matches_wildcard(fp + 1, wc + 1);
 
-        if(cbrew_project_config_compile(project, config, project_files, project_files_count))
+    if (*wc == '[')
+    {
+        const char *endBracket = strchr(wc, ']');
+        if (endBracket == NULL)
+            return CBREW_FALSE;
+        CbrewBool inRange = CBREW_FALSE;
+        for (const char *c = wc+1; c < endBracket; c++)
         {
-            switch(project->type)
+            if (*c == '-' && c > wc+1 && c < endBracket-1 && isalnum(*(c-1)) && isalnum(*(c+1)))
             {
-                case CBREW_PROJECT_TYPE_APP:
-                {
-                    if(!cbrew_project_config_link(project, config))
-                    {
-                        CBREW_LOG_ERROR("Failed to create executable for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
-                        project_success = CBREW_FALSE;
-                        config_success = CBREW_FALSE;
-                    }
+                if (*(c-1) <= *fp && *fp <= *(c+1))
+                    inRange = CBREW_TRUE;
+            }
+            else if (*c == *fp)
+                inRange = CBREW_TRUE;
+        }
+        if (inRange)
+            return cbrew_file_matches_wildcard(endBracket+1, fp+1);
+        else
+            return CBREW_FALSE;
+    }
 
-                    break;
-                }
+    if (*wc == '*' && *(wc + 1) == '*')
+    {
+        wc += 2;
 
-                case CBREW_PROJECT_TYPE_STATIC_LIB:
-                {
-                    if(!cbrew_project_config_compile_static_lib(project, config))
-                    {
-                        CBREW_LOG_ERROR("Failed to create Static Lib for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
-                        project_success = CBREW_FALSE;
-                        config_success = CBREW_FALSE;
-                    }
+        if(*wc == '\0')
+            return CBREW_TRUE;
 
-                    break;
-                }
+        for(size_t i = 0; i < strlen(fp); ++i)
+        {
+            if(cbrew_file_matches_wildcard(fp + i, wc))
+                return CBREW_TRUE;
+        }
 
-                case CBREW_PROJECT_TYPE_DYNAMIC_LIB:
-                {
-                    if(!cbrew_project_config_compile_dynamic_lib(project, config))
-                    {
-                        CBREW_LOG_ERROR("Failed to create Dynamic Lib for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
-                        project_success = CBREW_FALSE;
-                        config_success = CBREW_FALSE;
-                    }
+        return CBREW_FALSE;
+    }
+
+    if (*wc == '*')
+    {
+        ++wc;
+
+        if(*wc == '\0')
+            return strchr(fp, CBREW_PATH_SEPARATOR) == NULL;
+
+        for(size_t i = 0; i < strlen(fp); ++i)
+        {
+            if(cbrew_file_matches_wildcard(fp + i, wc))
+                return CBREW_TRUE;
+        }
+    }
+
+    return CBREW_FALSE;
+}
+
+#ifdef CBREW_PLATFORM_WINDOWS
+
+void cbrew_executable_filepath(char* filepath, const char* argv0)
+{
+    CBREW_ASSERT(filepath != NULL);
+    CBREW_ASSERT(argv0 != NULL);
 
-                    break;
-                }
+    const char* dot = strrchr(argv0, '.');
+    if(dot == NULL)
+        sprintf(filepath, "%s.exe", argv0);
+    else
+        strcpy(filepath, argv0);
+}
 
-                default: CBREW_ASSERT(CBREW_FALSE);
-            }
-        }
-        else
-        {
-            CBREW_LOG_ERROR("Failed to compile source files for config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
-            project_success = CBREW_FALSE;
-            config_success = CBREW_FALSE;
-        }
+double cbrew_time_ms(void)
+{
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
 
-        const clock_t config_end = clock();
-        const double config_building_time = (((double) config_end - config_start) / CLOCKS_PER_SEC) * 1000;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
 
-        if(config_success)
-            CBREW_LOG_INFO("Successfully built config %s%s %s(%.0lfms)", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_TIME, config_building_time);
-        else
-            CBREW_LOG_ERROR("Failed to build config %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_ERROR);
-    }
+    return ((double) counter.QuadPart / frequency.QuadPart) * 1000;
+}
 
-    for(size_t i = 0; i < project_files_count; ++i)
-        free(project_files[i]);
+CbrewBool cbrew_process_kill(CbrewProcess* process)
+{
+    CBREW_ASSERT(process != NULL);
 
-    free(project_files);
+    if(process->job != NULL)
+        return TerminateJobObject(process->job, EXIT_FAILURE);
 
-    const clock_t project_end = clock();
-    const double project_building_time = (((double) project_end - project_start) / CLOCKS_PER_SEC) * 1000;
+    return TerminateProcess(process->handle, EXIT_FAILURE);
+}
 
-    if(project_success)
-    {
-        CBREW_LOG_INFO("Successfully built project %s%s %s(%.0lfms)", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_TIME, project_building_time);
-        return CBREW_TRUE;
-    }
+size_t cbrew_processor_count(void)
+{
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
 
-    CBREW_LOG_ERROR("Failed to build project %s%s%s!", CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_ERROR);
-    return CBREW_FALSE;
+    return system_info.dwNumberOfProcessors > 0 ? system_info.dwNumberOfProcessors : 1;
 }
 
-CbrewBool cbrew_project_config_file_is_already_compiled(const CbrewProject* project, const CbrewConfig* config, const char* filepath)
+CbrewBool cbrew_process_start(CbrewProcess* process, const char* cmd, CbrewBool capture_output, CbrewBool own_group)
 {
-    const char* filename = strrchr(filepath, CBREW_PATH_SEPARATOR);
-    filename = filename == NULL ? filepath : filename + 1;
+    CBREW_ASSERT(process != NULL);
+    CBREW_ASSERT(cmd != NULL);
 
-    char obj_filepath[CBREW_FILEPATH_MAX];
-    sprintf(obj_filepath, "%s%c%s", config->obj_dir, CBREW_PATH_SEPARATOR, filename);
+    // Waiting for pipes and processes at the same time isn't possible with WaitForMultipleObjects
+    (void) capture_output;
 
-    char* extension = strrchr(obj_filepath, '.');
-    if(extension != NULL)
-    {
-        extension[1] = 'o';
-        extension[2] = '\0';
-    }
-    else
-    {
-        size_t obj_filepath_len = strlen(obj_filepath);
-        obj_filepath[obj_filepath_len] = '.';
-        obj_filepath[obj_filepath_len + 1] = 'o';
-        obj_filepath[obj_filepath_len + 2] = '\0';
-    }
+    memset(process, 0, sizeof(CbrewProcess));
 
-    if(!cbrew_file_exists(obj_filepath))
-        return CBREW_FALSE;
+    char* command_line = cbrew_create_str("cmd.exe /S /C \"%s\"", cmd);
 
-    char* include_dirs = cbrew_create_include_dirs_str(project->include_dirs, project->include_dirs_count);
-    char dependency_command[strlen(CBREW_COMPILER) + strlen(" ") + strlen(include_dirs) + strlen(" -MM ") + CBREW_FILEPATH_MAX];
-    sprintf(dependency_command, "%s %s-MM %s", CBREW_COMPILER, include_dirs, filepath);
-    free(include_dirs);
+    STARTUPINFO startup_info;
+    memset(&startup_info, 0, sizeof(STARTUPINFO));
+    startup_info.cb = sizeof(STARTUPINFO);
 
-    FILE* command_pipe = popen(dependency_command, "r");
+    PROCESS_INFORMATION process_info;
+    memset(&process_info, 0, sizeof(PROCESS_INFORMATION));
 
-    if(command_pipe == NULL)
-        return CBREW_FALSE;
+    // Grouped processes are started suspended, so they can't start any process outside of their job
+    HANDLE job = own_group ? CreateJobObject(NULL, NULL) : NULL;
+
+    BOOL created = CreateProcess(NULL, command_line, NULL, NULL, TRUE, job != NULL ? CREATE_SUSPENDED : 0, NULL, NULL, &startup_info, &process_info);
+
+    free(command_line);
 
-    char dependency_str[256 * CBREW_FILEPATH_MAX];
-    if(fgets(dependency_str, sizeof(dependency_str), command_pipe) == NULL)
+    if(!created)
     {
-        pclose(command_pipe);
+        if(job != NULL)
+            CloseHandle(job);
+
         return CBREW_FALSE;
     }
 
-    dependency_str[strlen(dependency_str) - 1] = '\0';
-
-    char* dependency = strtok(dependency_str, " ");
-    while((dependency = strtok(NULL, " ")) != NULL)
+    if(job != NULL)
     {
-        cbrew_path(dependency);
-
-        if(cbrew_first_file_is_older(obj_filepath, dependency))
+        if(!AssignProcessToJobObject(job, process_info.hProcess))
         {
-            pclose(command_pipe);
-
-            return CBREW_FALSE;
+            CloseHandle(job);
+            job = NULL;
         }
+
+        ResumeThread(process_info.hThread);
     }
 
-    pclose(command_pipe);
+    CloseHandle(process_info.hThread);
+
+    process->handle = process_info.hProcess;
+    process->job = job;
 
     return CBREW_TRUE;
 }
 
-CbrewBool cbrew_project_config_compile(const CbrewProject* project, const CbrewConfig* config, char** project_files, size_t project_files_count)
+CbrewBool cbrew_process_wait_any(CbrewProcess* processes, size_t processes_count, int timeout_ms, size_t* index, CbrewBool* success, size_t* peak_memory_kb)
 {
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(config != NULL);
-    CBREW_ASSERT(project_files != NULL);
+    CBREW_ASSERT(processes != NULL);
+    CBREW_ASSERT(processes_count > 0 && processes_count <= MAXIMUM_WAIT_OBJECTS);
+    CBREW_ASSERT(index != NULL);
+    CBREW_ASSERT(success != NULL);
 
-    if(!cbrew_dir_exists(config->obj_dir))
-        cbrew_dir_create(config->obj_dir);
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+    for(size_t i = 0; i < processes_count; ++i)
+        handles[i] = processes[i].handle;
 
-    char* project_flags = cbrew_create_flags_str(project->flags, project->flags_count);
-    char* project_defines = cbrew_create_defines_str(project->defines, project->defines_count);
-    char* include_dirs = cbrew_create_include_dirs_str(project->include_dirs, project->include_dirs_count);
+    DWORD result = WaitForMultipleObjects((DWORD) processes_count, handles, FALSE, timeout_ms < 0 ? INFINITE : (DWORD) timeout_ms);
 
-    char* config_flags = cbrew_create_flags_str(config->flags, config->flags_count);
-    char* config_defines = cbrew_create_defines_str(config->defines, config->defines_count);
+    if(result < WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + processes_count)
+        return CBREW_FALSE;
 
-    CbrewBool result = CBREW_TRUE;
+    *index = result - WAIT_OBJECT_0;
 
-    for(size_t i = 0; i < project_files_count; ++i)
-    {
-        CBREW_ASSERT(project_files[i] != NULL);
+    DWORD exit_code = EXIT_FAILURE;
+    GetExitCodeProcess(handles[*index], &exit_code);
+    CloseHandle(handles[*index]);
 
-        const char* filename = strrchr(project_files[i], CBREW_PATH_SEPARATOR);
-        filename = filename == NULL ? project_files[i] : filename + 1;
+    if(processes[*index].job != NULL)
+        CloseHandle(processes[*index].job);
 
-        // NOTE: This can lead to problems based on the dependencies of the source files
-        // For now we just disable incremental builds (shouldn't be needed anyway...)
+    *success = exit_code == EXIT_SUCCESS;
 
-        /*if(cbrew_project_config_file_is_already_compiled(project, config, project_files[i]))
-            continue;*/
+    // The memory usage of the processes started by cmd.exe is not accessible here
+    if(peak_memory_kb != NULL)
+        *peak_memory_kb = 0;
 
-        size_t filename_len = strlen(filename);
-        char obj_file[CBREW_FILENAME_MAX];
-        strcpy(obj_file, filename);
-        char* extension = strrchr(obj_file, '.');
-        if(extension != NULL)
-        {
-            extension[1] = 'o';
-            extension[2] = '\0';
-        }
-        else
-        {
-            obj_file[filename_len] = '.';
-            obj_file[filename_len + 1] = 'o';
-            obj_file[filename_len + 2] = '\0';
-        }
+    return CBREW_TRUE;
+}
 
-        result = cbrew_command("%s %s%s%s%s%s-c -o \"%s%c%s\" \"%s\"", CBREW_COMPILER, include_dirs, project_flags, config_flags, project_defines, config_defines, config->obj_dir, CBREW_PATH_SEPARATOR, obj_file, project_files[i]);
+void cbrew_process_read_output(CbrewProcess* process)
+{
+    CBREW_ASSERT(process != NULL);
+}
 
-        if(!result)
-            break;
-    }
+CbrewBool cbrew_console_is_interactive(void)
+{
+    return _isatty(_fileno(stdout)) != 0;
+}
 
-    free(project_flags);
-    free(project_defines);
-    free(include_dirs);
+size_t cbrew_available_memory_kb(void)
+{
+    MEMORYSTATUSEX status;
+    memset(&status, 0, sizeof(MEMORYSTATUSEX));
+    status.dwLength = sizeof(MEMORYSTATUSEX);
 
-    free(config_flags);
-    free(config_defines);
+    if(!GlobalMemoryStatusEx(&status))
+        return 0;
 
-    return result;
+    return (size_t) (status.ullAvailPhys / 1024);
 }
 
-CbrewBool cbrew_project_config_compile_static_lib(const CbrewProject* project, const CbrewConfig* config)
+double cbrew_load_average(void)
 {
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(config != NULL);
+    return 0.0;
+}
 
-    char* obj_files = cbrew_config_create_obj_files_str(config);
+char** cbrew_command_line_args(size_t* args_count)
+{
+    CBREW_ASSERT(args_count != NULL);
 
-    if(!cbrew_dir_exists(config->target_dir))
-        cbrew_dir_create(config->target_dir);
+    *args_count = __argc > 1 ? (size_t) __argc - 1 : 0;
 
-    CbrewBool result = cbrew_command("ar rcs \"%s%c%s%s.%s\" %s", config->target_dir, CBREW_PATH_SEPARATOR, CBREW_LIB_PREFIX, project->name, CBREW_STATIC_LIB_EXTENSION, obj_files);
+    char** args = malloc((*args_count + 1) * sizeof(char*));
 
-    free(obj_files);
+    for(size_t i = 0; i < *args_count; ++i)
+        args[i] = strdup(__argv[i + 1]);
 
-    return result;
+    return args;
 }
 
-CbrewBool cbrew_project_config_compile_dynamic_lib(const CbrewProject* project, const CbrewConfig* config)
+// NOTE: make uses named semaphores as jobserver on Windows, which cbrew does not support yet
+CbrewBool cbrew_jobserver_init(CbrewJobserver* jobserver, size_t jobs)
 {
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(jobserver != NULL);
 
-    char* obj_files = cbrew_config_create_obj_files_str(config);
-
-    if(!cbrew_dir_exists(config->target_dir))
-        cbrew_dir_create(config->target_dir);
+    (void) jobs;
 
-    char* project_flags = cbrew_create_flags_str(project->flags, project->flags_count);
-    char* config_flags = cbrew_create_flags_str(config->flags, config->flags_count);
+    memset(jobserver, 0, sizeof(CbrewJobserver));
 
-    CbrewBool result = cbrew_command("%s -shared %s%s-o \"%s%c%s.%s\" %s", CBREW_COMPILER, project_flags, config_flags, config->target_dir, CBREW_PATH_SEPARATOR, project->name, CBREW_DYNAMIC_LIB_EXTENSION, obj_files);
+    return CBREW_TRUE;
+}
 
-    free(project_flags);
-    free(config_flags);
+CbrewBool cbrew_jobserver_read_token(CbrewJobserver* jobserver, int timeout_ms, char* token)
+{
+    (void) jobserver;
+    (void) timeout_ms;
+    (void) token;
 
-    free(obj_files);
+    return CBREW_FALSE;
+}
 
-    return result;
+void cbrew_jobserver_write_token(CbrewJobserver* jobserver, char token)
+{
+    (void) jobserver;
+    (void) token;
 }
 
-CbrewBool cbrew_project_config_link(const CbrewProject* project, const CbrewConfig* config)
+CbrewBool cbrew_first_file_is_older(const char* first_file, const char* second_file)
 {
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(config != NULL);
+    CBREW_ASSERT(first_file != NULL);
+    CBREW_ASSERT(second_file != NULL);
 
-    char* obj_files = cbrew_config_create_obj_files_str(config);
 
-    if(!cbrew_dir_exists(config->target_dir))
-        cbrew_dir_create(config->target_dir);
+    char first_path[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(first_path, first_file));
+    WIN32_FIND_DATA first_path_fd;
+	HANDLE first_path_find = FindFirstFile(first_path, &first_path_fd);
+
+    if(first_path_find == INVALID_HANDLE_VALUE || first_path_fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+    {
+        FindClose(first_path_find);
+        return CBREW_FALSE;
+    }
+
+    char second_path[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(second_path, second_file));
+    WIN32_FIND_DATA second_path_fd;
+    HANDLE second_path_find = FindFirstFile(second_path, &second_path_fd);
 
-    char* include_dirs = cbrew_create_include_dirs_str(project->include_dirs, project->include_dirs_count);
+    if(second_path_find == INVALID_HANDLE_VALUE || second_path_fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+    {
+        FindClose(first_path_find);
+        FindClose(second_path_find);
 
-    char* project_flags = cbrew_create_flags_str(project->flags, project->flags_count);
-    char* project_links = cbrew_create_links_str(project->links, project->links_count);
+        return CBREW_FALSE;
+    }
 
-    char* config_flags = cbrew_create_flags_str(config->flags, config->flags_count);
+    CbrewBool result = CompareFileTime(&second_path_fd.ftLastWriteTime, &first_path_fd.ftLastWriteTime) == 1;
 
-    CbrewBool result = cbrew_command("%s %s%s%s-o \"%s%c%s\" %s %s", CBREW_COMPILER, include_dirs, project_flags, config_flags, config->target_dir, CBREW_PATH_SEPARATOR, project->name, obj_files, project_links);
+    FindClose(first_path_find);
+    FindClose(second_path_find);
 
-    free(include_dirs);
+    return result;
+}
 
-    free(project_flags);
-    free(project_links);
+uint64_t cbrew_file_mtime(const char* file)
+{
+    CBREW_ASSERT(file != NULL);
 
-    free(config_flags);
+    char path[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(path, file));
 
-    free(obj_files);
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if(!GetFileAttributesEx(path, GetFileExInfoStandard, &attributes))
+        return 0;
 
-    return result;
+    return ((uint64_t) attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
 }
 
-/* Configs */
+CbrewBool cbrew_file_rename(const char* old_name, const char* new_name)
+{
+    CBREW_ASSERT(old_name != NULL);
+    CBREW_ASSERT(new_name != NULL);
 
-CbrewConfig* cbrew_project_config_create(CbrewProject* project, const char* name, const char* target_dir, const char* obj_dir)
+    char old_name_path[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(old_name_path, old_name));
+
+    char new_name_path[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(new_name_path, new_name));
+
+    CbrewBool result = MoveFileEx(old_name_path, new_name_path, MOVEFILE_REPLACE_EXISTING) != 0;
+
+    return result;
+}
+
+CbrewBool cbrew_file_copy(const char* src_path, const char* dest_path)
 {
-    CBREW_ASSERT(project != NULL);
-    CBREW_ASSERT(name != NULL);
-    CBREW_ASSERT(target_dir != NULL);
-    CBREW_ASSERT(obj_dir != NULL);
+    CBREW_ASSERT(src_path != NULL);
+    CBREW_ASSERT(dest_path != NULL);
 
-    for(size_t i = 0; i < project->configs_count; ++i)
+    char src[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(src, src_path));
+
+    char dest[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(dest, dest_path));
+
+    // CopyFile keeps the attributes and the modification time, and clones the file on filesystems like ReFS
+    if(!CopyFile(src, dest, FALSE))
     {
-        if(strcmp(project->configs[i].name, name) == 0)
-        {
-            CBREW_LOG_WARN("Config with name %s%s%s already exists for project %s%s%s!", CBREW_CONSOLE_COLOR_CONFIG, name, CBREW_CONSOLE_COLOR_WARN, CBREW_CONSOLE_COLOR_PROJECT, project->name, CBREW_CONSOLE_COLOR_WARN);
-            return &project->configs[i];
-        }
+        CBREW_LOG_ERROR("Failed to copy %s to %s (error %lu)!", src, dest, (unsigned long) GetLastError());
+        return CBREW_FALSE;
     }
 
-    ++project->configs_count;
-    project->configs = realloc(project->configs, project->configs_count * sizeof(CbrewConfig));
+    return CBREW_TRUE;
+}
 
-    CbrewConfig* config = &project->configs[project->configs_count - 1];
+CbrewBool cbrew_file_link(const char* src_path, const char* link_path)
+{
+    CBREW_ASSERT(src_path != NULL);
+    CBREW_ASSERT(link_path != NULL);
 
-    memset(config, 0, sizeof(CbrewConfig));
+    char src[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(src, src_path));
 
-    config->name = name;
-    config->target_dir = cbrew_path(strdup(target_dir));
-    config->obj_dir = cbrew_path(strdup(obj_dir));
+    char link[CBREW_FILEPATH_MAX];
+    cbrew_path(strcpy(link, link_path));
 
-    return config;
+    return CreateHardLink(link, src, NULL) != 0;
 }
 
-void cbrew_config_add_flag(CbrewConfig* config, const char* flag)
+char** cbrew_find_files(const char* dir, size_t* files_count)
 {
-    CBREW_ASSERT(config != NULL);
-    CBREW_ASSERT(flag != NULL);
+    CBREW_ASSERT(dir != NULL);
+
+    char** files = NULL;
+
+	size_t files_found = 0;
+
+    char dir_search_path[CBREW_FILEPATH_MAX];
+    strcpy(dir_search_path, dir);
+    cbrew_path(dir_search_path);
+    strcat(dir_search_path, "\\*");
+
+	WIN32_FIND_DATA fd;
+	HANDLE find = FindFirstFile(dir_search_path, &fd);
+
+	if (find != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && strcmp(fd.cFileName, ".") != 0 && strcmp(fd.cFileName, "..") != 0)
+			{
+				++files_found;
+				files = realloc(files, files_found * sizeof(char*));
+
+				files[files_found - 1] = malloc((strlen(dir) + 1 + strlen(fd.cFileName) + 1) * sizeof(char));
+                sprintf(files[files_found - 1], "%s%c%s", dir, CBREW_PATH_SEPARATOR, fd.cFileName);
+			}
+		} while (FindNextFile(find, &fd));
+
+		FindClose(find);
+	}
+
+	if (files_count != NULL)
+		*files_count = files_found;
 
-    ++config->flags_count;
-    config->flags = realloc(config->flags, config->flags_count * sizeof(char*));
-    config->flags[config->flags_count - 1] = strdup(flag);
+	return files;
 }
 
-void cbrew_config_add_define(CbrewConfig* config, const char* define)
+char** cbrew_find_files_recursive(const char* dir, size_t* files_count)
 {
-    CBREW_ASSERT(config != NULL);
-    CBREW_ASSERT(define != NULL);
+    CBREW_ASSERT(dir != NULL);
+
+    char** files = NULL;
+
+	size_t files_found = 0;
+
+    char dir_search_path[CBREW_FILEPATH_MAX];
+    strcpy(dir_search_path, dir);
+    cbrew_path(dir_search_path);
+    strcat(dir_search_path, "\\*");
+
+	WIN32_FIND_DATA fd;
+	HANDLE find = FindFirstFile(dir_search_path, &fd);
+
+	if (find != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+			{
+				++files_found;
+				files = realloc(files, files_found * sizeof(char*));
+
+				files[files_found - 1] = malloc((strlen(dir) + 1 + strlen(fd.cFileName) + 1) * sizeof(char));
+                sprintf(files[files_found - 1], "%s%c%s", dir, CBREW_PATH_SEPARATOR, fd.cFileName);
+			}
+            else if(strcmp(fd.cFileName, ".") != 0 && strcmp(fd.cFileName, "..") != 0)
+            {
+                char sub_dir[CBREW_FILEPATH_MAX];
+                sprintf(sub_dir, "%s%c%s", dir, CBREW_PATH_SEPARATOR, fd.cFileName);
+
+                size_t sub_files_count = 0;
+                char** sub_files = cbrew_find_files_recursive(sub_dir, &sub_files_count);
 
-    ++config->defines_count;
-    config->defines = realloc(config->defines, config->defines_count * sizeof(char*));
-    config->defines[config->defines_count - 1] = strdup(define);
-}
+                files = realloc(files, (files_found + sub_files_count) * sizeof(char*));
 
-char* cbrew_config_create_obj_files_str(const CbrewConfig* config)
-{
-    CBREW_ASSERT(config != NULL);
+                for(size_t i = 0; i < sub_files_count; ++i)
+                    files[files_found + i] = sub_files[i];
 
-    char obj_file_wildcard[CBREW_FILEPATH_MAX];
-    sprintf(obj_file_wildcard, "%s%c*.o", config->obj_dir, CBREW_PATH_SEPARATOR);
+				files_found += sub_files_count;
 
-    size_t obj_files_count = 0;
-    char** obj_files = cbrew_find_files(config->obj_dir, &obj_files_count);
+                free(sub_files);
+            }
+		} while (FindNextFile(find, &fd));
 
-    size_t obj_files_buffer_len = 0;
-    for(size_t i = 0; i < obj_files_count; ++i)
-    {
-        if(!cbrew_file_matches_wildcard(obj_files[i], obj_file_wildcard))
-            continue;
+		FindClose(find);
+	}
 
-        obj_files_buffer_len += strlen("\"") + strlen(obj_files[i]) + strlen("\"") + strlen(" ");
-    }
+	if (files_count != NULL)
+		*files_count = files_found;
 
-    if(obj_files_buffer_len == 0)
-    {
-        CBREW_LOG_WARN("Config %s%s%s has no object files!", CBREW_CONSOLE_COLOR_CONFIG, config->name, CBREW_CONSOLE_COLOR_WARN);
+	return files;
+}
 
-        for(size_t i = 0; i < obj_files_count; ++i)
-            free(obj_files[i]);
+CbrewBool cbrew_dir_exists(const char* dir)
+{
+    CBREW_ASSERT(dir != NULL);
 
-        free(obj_files);
+    DWORD file_attributes = GetFileAttributes(dir);
 
-        return calloc(1, sizeof(char));
-    }
+    return file_attributes != INVALID_FILE_ATTRIBUTES && (file_attributes & FILE_ATTRIBUTE_DIRECTORY);
+}
 
-    char* obj_files_buffer = calloc(obj_files_buffer_len + 1, sizeof(char));
+CbrewBool cbrew_dir_create(const char* dir)
+{
+    CBREW_ASSERT(dir != NULL);
 
-    for(size_t i = 0; i < obj_files_count; ++i)
+    for(size_t i = 0; i < strlen(dir); ++i)
     {
-        if(!cbrew_file_matches_wildcard(obj_files[i], obj_file_wildcard))
+        if(dir[i] != CBREW_PATH_SEPARATOR)
             continue;
 
-        sprintf(obj_files_buffer + strlen(obj_files_buffer), "\"%s\" ", obj_files[i]);
-    }
-
-    for(size_t i = 0; i < obj_files_count; ++i)
-        free(obj_files[i]);
+        char dir_path[CBREW_FILEPATH_MAX];
+        strncpy(dir_path, dir, i);
+        dir_path[i] = '\0';
 
-    free(obj_files);
+        if(CreateDirectory(dir_path, NULL) == 0 && GetLastError() != ERROR_ALREADY_EXISTS)
+            return CBREW_FALSE;
+    }
 
-    obj_files_buffer[obj_files_buffer_len - 1] = '\0';
+    if(CreateDirectory(dir, NULL) != 0)
+        return CBREW_TRUE;
 
-    return obj_files_buffer;
+    return GetLastError() != ERROR_ALREADY_EXISTS;
 }
 
-/* Util */
+#elif defined(CBREW_PLATFORM_LINUX)
 
-char* cbrew_path(char* path)
+void cbrew_executable_filepath(char* filepath, const char* argv0)
 {
-    CBREW_ASSERT(path != NULL);
-
-    for(size_t i = 0; i < strlen(path); ++i)
-    {
-        if(path[i] == '/')
-            path[i] = CBREW_PATH_SEPARATOR;
-    }
+    CBREW_ASSERT(filepath != NULL);
+    CBREW_ASSERT(argv0 != NULL);
 
-    return path;
+    strcpy(filepath, argv0);
 }
 
-char* cbrew_create_flags_str(char** flags, size_t flags_count)
+double cbrew_time_ms(void)
 {
-    if(flags == NULL || flags_count == 0)
-        return calloc(1, sizeof(char));
-
-    size_t len = 0;
-    for(size_t i = 0; i < flags_count; ++i)
-        len += strlen(flags[i]) + strlen(" ");
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
 
-    char* flags_str = calloc(len + 1, sizeof(char));
-
-    for(size_t i = 0; i < flags_count; ++i)
-        sprintf(flags_str + strlen(flags_str), "%s ", flags[i]);
-
-    return flags_str;
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
 }
 
-char* cbrew_create_defines_str(char** defines, size_t defines_count)
+CbrewBool cbrew_process_kill(CbrewProcess* process)
 {
-    if(defines == NULL || defines_count == 0)
-        return calloc(1, sizeof(char));
-
-    size_t len = 0;
-    for(size_t i = 0; i < defines_count; ++i)
-        len += strlen("-D") + strlen(defines[i]) + strlen(" ");
+    CBREW_ASSERT(process != NULL);
 
-    char* defines_str = calloc(len + 1, sizeof(char));
-
-    for(size_t i = 0; i < defines_count; ++i)
-        sprintf(defines_str + strlen(defines_str), "-D%s ", defines[i]);
+    // The shell may start the command as a child, which is only stopped together with its process group
+    if(process->group)
+        return kill(-process->pid, SIGKILL) == 0;
 
-    return defines_str;
+    return kill(process->pid, SIGKILL) == 0;
 }
 
-char* cbrew_create_include_dirs_str(char** include_dirs, size_t include_dirs_count)
+size_t cbrew_processor_count(void)
 {
-    if(include_dirs == NULL || include_dirs_count == 0)
-        return calloc(1, sizeof(char));
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
 
-    size_t len = 0;
-    for(size_t i = 0; i < include_dirs_count; ++i)
-        len += strlen("-I") + strlen(include_dirs[i]) + strlen(" ");
-
-    char* include_dirs_str = calloc(len + 1, sizeof(char));
-
-    for(size_t i = 0; i < include_dirs_count; ++i)
-        sprintf(include_dirs_str + strlen(include_dirs_str), "-I%s ", include_dirs[i]);
-
-    return include_dirs_str;
+    return processors > 0 ? (size_t) processors : 1;
 }
 
-char* cbrew_create_links_str(char** links, size_t links_count)
+CbrewBool cbrew_process_start(CbrewProcess* process, const char* cmd, CbrewBool capture_output, CbrewBool own_group)
 {
-    if(links == NULL || links_count == 0)
-        return calloc(1, sizeof(char));
+    CBREW_ASSERT(process != NULL);
+    CBREW_ASSERT(cmd != NULL);
 
-    size_t len = 0;
-    for(size_t i = 0; i < links_count; ++i)
-        len += strlen("-L. ") + strlen("-l") + strlen(links[i]) + strlen(" ");
+    memset(process, 0, sizeof(CbrewProcess));
+    process->output_fd = -1;
 
-    char* links_str = calloc(len + 1, sizeof(char));
+    // stdout and stderr share one pipe, so the order of the messages is kept
+    int output_pipe[2] = { -1, -1 };
+    if(capture_output && pipe(output_pipe) != 0)
+        return CBREW_FALSE;
 
-    char link_dir[CBREW_FILEPATH_MAX];
-    char link_name[CBREW_FILENAME_MAX];
-    for(size_t i = 0; i < links_count; ++i)
+    // Buffered output would otherwise be written by both processes
+    fflush(NULL);
+
+    pid_t pid = fork();
+
+    if(pid < 0)
     {
-        const char* last_slash = strrchr(links[i], CBREW_PATH_SEPARATOR);
-        if(last_slash == NULL)
-        {
-            strcpy(link_dir, ".");
-            strcpy(link_name, links[i]);
-        }
-        else
+        if(capture_output)
         {
-            strcpy(link_dir, links[i]);
-            *strrchr(link_dir, CBREW_PATH_SEPARATOR) = '\0';
-            strcpy(link_name, last_slash + 1);
+            close(output_pipe[0]);
+            close(output_pipe[1]);
         }
 
-        sprintf(links_str + strlen(links_str), "-L%s -l%s ", link_dir, link_name);
+        return CBREW_FALSE;
     }
 
-    return links_str;
-}
+    if(pid == 0)
+    {
+        if(own_group)
+            setpgid(0, 0);
 
-CbrewBool cbrew_file_copy(const char* src_path, const char* dest_path)
-{
-    FILE* src = fopen(src_path, "rb");
+        if(capture_output)
+        {
+            dup2(output_pipe[1], STDOUT_FILENO);
+            dup2(output_pipe[1], STDERR_FILENO);
+            close(output_pipe[0]);
+            close(output_pipe[1]);
+        }
 
-    if(src == NULL)
-        return CBREW_FALSE;
+        execl("/bin/sh", "sh", "-c", cmd, (char*) NULL);
+        _exit(127);
+    }
 
-    FILE* dest = fopen(dest_path, "wb");
+    process->pid = pid;
 
-    if(dest == NULL)
-    {
-        fclose(src);
-        return CBREW_FALSE;
-    }
+    // Both processes set the group, so it exists no matter which of them runs first
+    if(own_group)
+        process->group = setpgid(pid, pid) == 0 || errno == EACCES;
 
-    char buffer[4096];
-    while(!feof(src))
+    if(capture_output)
     {
-        size_t bytes = fread(buffer, sizeof(char), sizeof(buffer), src);
+        close(output_pipe[1]);
 
-        if(bytes > 0)
-            fwrite(buffer, sizeof(char), bytes, dest);
-    }
+        // Reading must never block, as the remaining output is collected after the process has finished
+        fcntl(output_pipe[0], F_SETFL, fcntl(output_pipe[0], F_GETFL) | O_NONBLOCK);
+        fcntl(output_pipe[0], F_SETFD, FD_CLOEXEC);
 
-    fclose(src);
-    fclose(dest);
+        process->output_fd = output_pipe[0];
+    }
 
     return CBREW_TRUE;
 }
 
-/* IO */
-
-CbrewBool cbrew_command(const char* format, ...)
+CbrewBool cbrew_process_wait_any(CbrewProcess* processes, size_t processes_count, int timeout_ms, size_t* index, CbrewBool* success, size_t* peak_memory_kb)
 {
-    CBREW_ASSERT(format != NULL);
-
-    char cmd[CBREW_COMMAND_LENGTH_MAX];
-
-    va_list args;
-    va_start(args, format);
-    vsprintf(cmd, format, args);
-    va_end(args);
-
-    CBREW_LOG_CMD(cmd);
-
-    CbrewBool result = system(cmd) == EXIT_SUCCESS;
+    CBREW_ASSERT(processes != NULL);
+    CBREW_ASSERT(processes_count > 0);
+    CBREW_ASSERT(index != NULL);
+    CBREW_ASSERT(success != NULL);
 
-    return result;
-}
+    struct pollfd* fds = malloc(processes_count * sizeof(struct pollfd));
+    size_t* fds_processes = malloc(processes_count * sizeof(size_t));
 
-CbrewBool cbrew_file_exists(const char* file)
-{
-    CBREW_ASSERT(file != NULL);
+    const double wait_end = cbrew_time_ms() + timeout_ms;
 
-    FILE* f = fopen(file, "r");
+    CbrewBool polled = CBREW_FALSE;
 
-    if(f == NULL)
-        return CBREW_FALSE;
+    while(CBREW_TRUE)
+    {
+        int status = 0;
+        struct rusage usage;
+        memset(&usage, 0, sizeof(struct rusage));
 
-    fclose(f);
+        size_t fds_count = 0;
+        for(size_t i = 0; i < processes_count; ++i)
+        {
+            if(processes[i].output_fd < 0)
+                continue;
 
-    return CBREW_TRUE;
-}
+            fds[fds_count].fd = processes[i].output_fd;
+            fds[fds_count].events = POLLIN;
+            fds[fds_count].revents = 0;
+            fds_processes[fds_count++] = i;
+        }
 
-CbrewBool cbrew_file_delete(const char* file)
-{
-    CBREW_ASSERT(file != NULL);
+        // A process that still writes into its pipe can't finish until the pipe is read,
+        // so the pipes are polled until one of them is closed because its process has finished
+        const CbrewBool block_in_wait = timeout_ms < 0 && fds_count == 0;
 
-    return remove(file) == 0;
-}
+        pid_t pid = wait4(-1, &status, block_in_wait ? 0 : WNOHANG, &usage);
 
-void cbrew_wildcard_directory(char* dir, const char* wildcard)
-{
-    CBREW_ASSERT(dir != NULL);
-    CBREW_ASSERT(wildcard != NULL);
+        if(pid < 0)
+        {
+            if(errno == EINTR)
+                continue;
 
-    cbrew_path(strcpy(dir, wildcard));
+            free(fds);
+            free(fds_processes);
 
-    for(size_t i = 0; i < strlen(dir); ++i)
-    {
-        if(dir[i] == '?' || dir[i] == '*' || dir[i] == '[')
-        {
-            dir[i] = '\0';
-            break;
+            return CBREW_FALSE;
         }
-    }
 
-    char* last_path_separator = strrchr(dir, CBREW_PATH_SEPARATOR);
-
-    if(last_path_separator != NULL)
-        *last_path_separator = '\0';
-    else
-        strcpy(dir, ".");
-}
+        if(pid == 0)
+        {
+            // Every process is checked at least once, even if the timeout has already passed
+            int poll_timeout_ms = -1;
+            if(timeout_ms >= 0)
+            {
+                const double remaining_ms = wait_end - cbrew_time_ms();
 
-CbrewBool cbrew_file_matches_wildcard(const char* filepath, const char* wildcard)
-{
-    CBREW_ASSERT(filepath != NULL);
-    CBREW_ASSERT(wildcard != NULL);
+                if(polled && remaining_ms <= 0.0)
+                {
+                    free(fds);
+                    free(fds_processes);
 
-    char filepath_pathed[CBREW_FILEPATH_MAX];
-    char wildcard_pathed[CBREW_FILEPATH_MAX];
+                    return CBREW_FALSE;
+                }
 
-    cbrew_path(strcpy(filepath_pathed, filepath));
-    cbrew_path(strcpy(wildcard_pathed, wildcard));
+                poll_timeout_ms = remaining_ms > 0.0 ? (int) remaining_ms + 1 : 0;
+            }
 
-    const char* fp = filepath_pathed;
-    const char* wc = wildcard_pathed;
+            polled = CBREW_TRUE;
 
-    if (*wc == '\0' && *fp == '\0')
-        return CBREW_TRUE;
+            // Processes without an open pipe can only be noticed by checking for them regularly
+            if(fds_count < processes_count && (poll_timeout_ms < 0 || poll_timeout_ms > 50))
+                poll_timeout_ms = 50;
 
-    if (*wc == '*' && *(wc + 1) != '\0' && *fp == '\0')
-        return CBREW_FALSE;
+            if(poll(fds, fds_count, poll_timeout_ms) < 0 && errno != EINTR)
+            {
+                free(fds);
+                free(fds_processes);
 
-    if (*wc == '?' || *wc == *fp)
-        return cbrew_file_matches_wildcard(fp + 1, wc + 1);
+                return CBREW_FALSE;
+            }
 
-    if (*wc == '[')
-    {
-        const char *endBracket = strchr(wc, ']');
-        if (endBracket == NULL)
-            return CBREW_FALSE;
-        CbrewBool inRange = CBREW_FALSE;
-        for (const char *c = wc+1; c < endBracket; c++)
-        {
-            if (*c == '-' && c > wc+1 && c < endBracket-1 && isalnum(*(c-1)) && isalnum(*(c+1)))
+            for(size_t i = 0; i < fds_count; ++i)
             {
-                if (*(c-1) <= *fp && *fp <= *(c+1))
-                    inRange = CBREW_TRUE;
+                if(fds[i].revents != 0)
+                    cbrew_process_read_output(&processes[fds_processes[i]]);
             }
-            else if (*c == *fp)
-                inRange = CBREW_TRUE;
+
+            continue;
         }
-        if (inRange)
-            return cbrew_file_matches_wildcard(endBracket+1, fp+1);
-        else
-            return CBREW_FALSE;
-    }
 
-    if (*wc == '*' && *(wc + 1) == '*')
-    {
-        wc += 2;
+        for(size_t i = 0; i < processes_count; ++i)
+        {
+            if(processes[i].pid != pid)
+                continue;
 
-        if(*wc == '\0')
-            return CBREW_TRUE;
+            // Everything the process has written is still inside the pipe
+            cbrew_process_read_output(&processes[i]);
 
-        for(size_t i = 0; i < strlen(fp); ++i)
-        {
-            if(cbrew_file_matches_wildcard(fp + i, wc))
-                return CBREW_TRUE;
-        }
+            if(processes[i].output_fd >= 0)
+            {
+                close(processes[i].output_fd);
+                processes[i].output_fd = -1;
+            }
 
-        return CBREW_FALSE;
-    }
+            free(fds);
+            free(fds_processes);
 
-    if (*wc == '*')
-    {
-        ++wc;
+            *index = i;
+            *success = WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
 
-        if(*wc == '\0')
-            return strchr(fp, CBREW_PATH_SEPARATOR) == NULL;
+            // The shell waits for the compiler, so the peak covers the compiler process as well
+            if(peak_memory_kb != NULL)
+                *peak_memory_kb = (size_t) usage.ru_maxrss;
 
-        for(size_t i = 0; i < strlen(fp); ++i)
-        {
-            if(cbrew_file_matches_wildcard(fp + i, wc))
-                return CBREW_TRUE;
+            return CBREW_TRUE;
         }
     }
-
-    return CBREW_FALSE;
-}
-
-#ifdef CBREW_PLATFORM_WINDOWS
-
-void cbrew_executable_filepath(char* filepath, const char* argv0)
-{
-    CBREW_ASSERT(filepath != NULL);
-    CBREW_ASSERT(argv0 != NULL);
-
-    const char* dot = strrchr(argv0, '.');
-    if(dot == NULL)
-        sprintf(filepath, "%s.exe", argv0);
-    else
-        strcpy(filepath, argv0);
 }
 
-CbrewBool cbrew_first_file_is_older(const char* first_file, const char* second_file)
-{
-    CBREW_ASSERT(first_file != NULL);
-    CBREW_ASSERT(second_file != NULL);
-
+size_t cbrew_available_memory_kb(void)
+{
+    FILE* f = fopen("/proc/meminfo", "r");
+    if(f == NULL)
+        return 0;
 
-    char first_path[CBREW_FILEPATH_MAX];
-    cbrew_path(strcpy(first_path, first_file));
-    WIN32_FIND_DATA first_path_fd;
-	HANDLE first_path_find = FindFirstFile(first_path, &first_path_fd);
+    size_t available_memory_kb = 0;
 
-    if(first_path_find == INVALID_HANDLE_VALUE || first_path_fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+    char line[256];
+    while(fgets(line, sizeof(line), f) != NULL)
     {
-        FindClose(first_path_find);
-        return CBREW_FALSE;
+        if(strncmp(line, "MemAvailable:", 13) == 0)
+        {
+            available_memory_kb = strtoull(line + 13, NULL, 10);
+            break;
+        }
     }
 
-    char second_path[CBREW_FILEPATH_MAX];
-    cbrew_path(strcpy(second_path, second_file));
-    WIN32_FIND_DATA second_path_fd;
-    HANDLE second_path_find = FindFirstFile(second_path, &second_path_fd);
+    fclose(f);
 
-    if(second_path_find == INVALID_HANDLE_VALUE || second_path_fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
-    {
-        FindClose(first_path_find);
-        FindClose(second_path_find);
+    return available_memory_kb;
+}
 
-        return CBREW_FALSE;
-    }
+double cbrew_load_average(void)
+{
+    FILE* f = fopen("/proc/loadavg", "r");
+    if(f == NULL)
+        return 0.0;
 
-    CbrewBool result = CompareFileTime(&second_path_fd.ftLastWriteTime, &first_path_fd.ftLastWriteTime) == 1;
+    double load = 0.0;
+    if(fscanf(f, "%lf", &load) != 1)
+        load = 0.0;
 
-    FindClose(first_path_find);
-    FindClose(second_path_find);
+    fclose(f);
 
-    return result;
+    return load;
 }
 
-CbrewBool cbrew_file_rename(const char* old_name, const char* new_name)
+void cbrew_process_read_output(CbrewProcess* process)
 {
-    CBREW_ASSERT(old_name != NULL);
-    CBREW_ASSERT(new_name != NULL);
+    CBREW_ASSERT(process != NULL);
 
-    char old_name_path[CBREW_FILEPATH_MAX];
-    cbrew_path(strcpy(old_name_path, old_name));
+    if(process->output_fd < 0)
+        return;
 
-    char new_name_path[CBREW_FILEPATH_MAX];
-    cbrew_path(strcpy(new_name_path, new_name));
+    while(CBREW_TRUE)
+    {
+        char buffer[4096];
+        const ssize_t read_count = read(process->output_fd, buffer, sizeof(buffer));
 
-    CbrewBool result = MoveFileEx(old_name_path, new_name_path, MOVEFILE_REPLACE_EXISTING) != 0;
+        if(read_count < 0 && errno == EINTR)
+            continue;
 
-    return result;
+        // The pipe is closed once the process and all of its children have finished
+        if(read_count == 0 || (read_count < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+        {
+            close(process->output_fd);
+            process->output_fd = -1;
+            return;
+        }
+
+        if(read_count < 0)
+            return;
+
+        cbrew_string_builder_reserve(&process->output, (size_t) read_count);
+        memcpy(process->output.data + process->output.len, buffer, (size_t) read_count);
+        process->output.len += (size_t) read_count;
+        process->output.data[process->output.len] = '\0';
+    }
 }
 
-char** cbrew_find_files(const char* dir, size_t* files_count)
+CbrewBool cbrew_console_is_interactive(void)
 {
-    CBREW_ASSERT(dir != NULL);
+    return isatty(STDOUT_FILENO) != 0;
+}
 
-    char** files = NULL;
+char** cbrew_command_line_args(size_t* args_count)
+{
+    CBREW_ASSERT(args_count != NULL);
 
-	size_t files_found = 0;
+    *args_count = 0;
 
-    char dir_search_path[CBREW_FILEPATH_MAX];
-    strcpy(dir_search_path, dir);
-    cbrew_path(dir_search_path);
-    strcat(dir_search_path, "\\*");
+    // main() of cbrew.c doesn't receive the arguments, but the kernel keeps them as NUL separated strings
+    FILE* f = fopen("/proc/self/cmdline", "r");
+    if(f == NULL)
+        return NULL;
 
-	WIN32_FIND_DATA fd;
-	HANDLE find = FindFirstFile(dir_search_path, &fd);
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
 
-	if (find != INVALID_HANDLE_VALUE)
-	{
-		do
-		{
-			if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && strcmp(fd.cFileName, ".") != 0 && strcmp(fd.cFileName, "..") != 0)
-			{
-				++files_found;
-				files = realloc(files, files_found * sizeof(char*));
+    char buffer[4096];
+    size_t read = 0;
+    while((read = fread(buffer, sizeof(char), sizeof(buffer), f)) > 0)
+    {
+        cbrew_string_builder_reserve(&sb, read);
+        memcpy(sb.data + sb.len, buffer, read);
+        sb.len += read;
+    }
 
-				files[files_found - 1] = malloc((strlen(dir) + 1 + strlen(fd.cFileName) + 1) * sizeof(char));
-                sprintf(files[files_found - 1], "%s%c%s", dir, CBREW_PATH_SEPARATOR, fd.cFileName);
-			}
-		} while (FindNextFile(find, &fd));
+    fclose(f);
 
-		FindClose(find);
-	}
+    char** args = NULL;
 
-	if (files_count != NULL)
-		*files_count = files_found;
+    // The first string is the name of the executable
+    size_t offset = sb.len > 0 ? strnlen(sb.data, sb.len) + 1 : 0;
 
-	return files;
+    while(offset < sb.len)
+    {
+        const size_t len = strnlen(sb.data + offset, sb.len - offset);
+
+        args = realloc(args, (*args_count + 1) * sizeof(char*));
+        args[*args_count] = strndup(sb.data + offset, len);
+        ++(*args_count);
+
+        offset += len + 1;
+    }
+
+    cbrew_string_builder_free(&sb);
+
+    return args;
 }
 
-char** cbrew_find_files_recursive(const char* dir, size_t* files_count)
+CbrewBool cbrew_jobserver_init(CbrewJobserver* jobserver, size_t jobs)
 {
-    CBREW_ASSERT(dir != NULL);
-
-    char** files = NULL;
+    CBREW_ASSERT(jobserver != NULL);
 
-	size_t files_found = 0;
+    memset(jobserver, 0, sizeof(CbrewJobserver));
+    jobserver->read_fd = -1;
+    jobserver->write_fd = -1;
 
-    char dir_search_path[CBREW_FILEPATH_MAX];
-    strcpy(dir_search_path, dir);
-    cbrew_path(dir_search_path);
-    strcat(dir_search_path, "\\*");
+    const char* makeflags = getenv("MAKEFLAGS");
 
-	WIN32_FIND_DATA fd;
-	HANDLE find = FindFirstFile(dir_search_path, &fd);
+    const char* auth = NULL;
+    size_t auth_prefix_len = 0;
 
-	if (find != INVALID_HANDLE_VALUE)
-	{
-		do
-		{
-			if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
-			{
-				++files_found;
-				files = realloc(files, files_found * sizeof(char*));
+    if(makeflags != NULL)
+    {
+        // Only the last occurrence is valid, as make appends its own options
+        static const char* auth_prefixes[] = { "--jobserver-auth=", "--jobserver-fds=" };
 
-				files[files_found - 1] = malloc((strlen(dir) + 1 + strlen(fd.cFileName) + 1) * sizeof(char));
-                sprintf(files[files_found - 1], "%s%c%s", dir, CBREW_PATH_SEPARATOR, fd.cFileName);
-			}
-            else if(strcmp(fd.cFileName, ".") != 0 && strcmp(fd.cFileName, "..") != 0)
+        for(size_t i = 0; i < sizeof(auth_prefixes) / sizeof(auth_prefixes[0]) && auth == NULL; ++i)
+        {
+            for(const char* found = strstr(makeflags, auth_prefixes[i]); found != NULL; found = strstr(found + 1, auth_prefixes[i]))
             {
-                char sub_dir[CBREW_FILEPATH_MAX];
-                sprintf(sub_dir, "%s%c%s", dir, CBREW_PATH_SEPARATOR, fd.cFileName);
+                auth = found;
+                auth_prefix_len = strlen(auth_prefixes[i]);
+            }
+        }
+    }
 
-                size_t sub_files_count = 0;
-                char** sub_files = cbrew_find_files_recursive(sub_dir, &sub_files_count);
+    if(auth != NULL)
+    {
+        auth += auth_prefix_len;
 
-                files = realloc(files, (files_found + sub_files_count) * sizeof(char*));
+        char auth_value[CBREW_FILEPATH_MAX];
+        size_t auth_len = strcspn(auth, " \t");
+        if(auth_len >= sizeof(auth_value))
+            auth_len = sizeof(auth_value) - 1;
 
-                for(size_t i = 0; i < sub_files_count; ++i)
-                    files[files_found + i] = sub_files[i];
+        memcpy(auth_value, auth, auth_len);
+        auth_value[auth_len] = '\0';
 
-				files_found += sub_files_count;
+        int read_fd = -1;
+        int write_fd = -1;
 
-                free(sub_files);
+        if(strncmp(auth_value, "fifo:", strlen("fifo:")) == 0)
+        {
+            read_fd = open(auth_value + strlen("fifo:"), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+            write_fd = read_fd;
+        }
+        else if(sscanf(auth_value, "%d,%d", &read_fd, &write_fd) == 2)
+        {
+            // make only passes the pipe to recipes that are marked as recursive
+            if(fcntl(read_fd, F_GETFD) < 0 || fcntl(write_fd, F_GETFD) < 0)
+            {
+                read_fd = -1;
+                write_fd = -1;
             }
-		} while (FindNextFile(find, &fd));
+        }
 
-		FindClose(find);
-	}
+        if(read_fd < 0 || write_fd < 0)
+        {
+            jobserver->unavailable = CBREW_TRUE;
+            return CBREW_FALSE;
+        }
 
-	if (files_count != NULL)
-		*files_count = files_found;
+        jobserver->read_fd = read_fd;
+        jobserver->write_fd = write_fd;
+    }
+    else
+    {
+        if(jobs <= 1)
+            return CBREW_TRUE;
 
-	return files;
-}
+        int fds[2];
+        if(pipe(fds) != 0)
+            return CBREW_TRUE;
 
-CbrewBool cbrew_dir_exists(const char* dir)
-{
-    CBREW_ASSERT(dir != NULL);
+        // The implicit token of every client is not part of the pipe
+        for(size_t i = 0; i + 1 < jobs; ++i)
+        {
+            if(write(fds[1], "+", 1) != 1)
+                break;
+        }
 
-    DWORD file_attributes = GetFileAttributes(dir);
+        char* new_makeflags = cbrew_create_str("%s -j%zu --jobserver-auth=%d,%d", makeflags == NULL ? "" : makeflags, jobs, fds[0], fds[1]);
+        setenv("MAKEFLAGS", new_makeflags, 1);
+        free(new_makeflags);
 
-    return file_attributes != INVALID_FILE_ATTRIBUTES && (file_attributes & FILE_ATTRIBUTE_DIRECTORY);
+        jobserver->read_fd = fds[0];
+        jobserver->write_fd = fds[1];
+        jobserver->server = CBREW_TRUE;
+    }
+
+    // Reopening a pipe creates a new file description, so O_NONBLOCK doesn't affect the other processes using it
+    char fd_path[64];
+    sprintf(fd_path, "/proc/self/fd/%d", jobserver->read_fd);
+
+    int nonblocking_fd = open(fd_path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if(nonblocking_fd >= 0)
+        jobserver->read_fd = nonblocking_fd;
+
+    jobserver->active = CBREW_TRUE;
+
+    return CBREW_TRUE;
 }
 
-CbrewBool cbrew_dir_create(const char* dir)
+CbrewBool cbrew_jobserver_read_token(CbrewJobserver* jobserver, int timeout_ms, char* token)
 {
-    CBREW_ASSERT(dir != NULL);
+    CBREW_ASSERT(jobserver != NULL);
+    CBREW_ASSERT(token != NULL);
 
-    for(size_t i = 0; i < strlen(dir); ++i)
-    {
-        if(dir[i] != CBREW_PATH_SEPARATOR)
-            continue;
+    struct pollfd pfd;
+    pfd.fd = jobserver->read_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
 
-        char dir_path[CBREW_FILEPATH_MAX];
-        strncpy(dir_path, dir, i);
-        dir_path[i] = '\0';
+    if(poll(&pfd, 1, timeout_ms) <= 0)
+        return CBREW_FALSE;
 
-        if(CreateDirectory(dir_path, NULL) == 0 && GetLastError() != ERROR_ALREADY_EXISTS)
-            return CBREW_FALSE;
-    }
+    return read(jobserver->read_fd, token, 1) == 1;
+}
 
-    if(CreateDirectory(dir, NULL) != 0)
-        return CBREW_TRUE;
+void cbrew_jobserver_write_token(CbrewJobserver* jobserver, char token)
+{
+    CBREW_ASSERT(jobserver != NULL);
 
-    return GetLastError() != ERROR_ALREADY_EXISTS;
+    while(write(jobserver->write_fd, &token, 1) < 0 && errno == EINTR);
 }
 
-#elif defined(CBREW_PLATFORM_LINUX)
-
-void cbrew_executable_filepath(char* filepath, const char* argv0)
+uint64_t cbrew_file_mtime(const char* file)
 {
-    CBREW_ASSERT(filepath != NULL);
-    CBREW_ASSERT(argv0 != NULL);
+    CBREW_ASSERT(file != NULL);
 
-    strcpy(filepath, argv0);
+    struct stat file_stat;
+
+    if(stat(file, &file_stat) != 0)
+        return 0;
+
+    return (uint64_t) file_stat.st_mtim.tv_sec * 1000000000ULL + (uint64_t) file_stat.st_mtim.tv_nsec;
 }
 
 CbrewBool cbrew_first_file_is_older(const char* first_file, const char* second_file)
@@ -1630,10 +8843,10 @@ CbrewBool cbrew_first_file_is_older(const char* first_file, const char* second_f
     struct stat first_stat;
     struct stat second_stat;
 
-    if (stat(first_file, &first_stat) != 0 || S_ISDIR(first_stat.st_mode))
+    if(stat(first_file, &first_stat) != 0 || S_ISDIR(first_stat.st_mode))
         return CBREW_FALSE;
 
-    if (stat(second_file, &second_stat) != 0 || S_ISDIR(second_stat.st_mode))
+    if(stat(second_file, &second_stat) != 0 || S_ISDIR(second_stat.st_mode))
         return CBREW_FALSE;
 
     return second_stat.st_mtime > first_stat.st_mtime;
@@ -1647,6 +8860,145 @@ CbrewBool cbrew_file_rename(const char* old_name, const char* new_name)
     return rename(old_name, new_name) == 0;
 }
 
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+
+CbrewBool cbrew_file_copy(const char* src_path, const char* dest_path)
+{
+    CBREW_ASSERT(src_path != NULL);
+    CBREW_ASSERT(dest_path != NULL);
+
+    const int src_fd = open(src_path, O_RDONLY | O_CLOEXEC);
+    if(src_fd < 0)
+    {
+        CBREW_LOG_ERROR("Failed to open %s: %s!", src_path, strerror(errno));
+        return CBREW_FALSE;
+    }
+
+    struct stat src_stat;
+    if(fstat(src_fd, &src_stat) != 0)
+    {
+        CBREW_LOG_ERROR("Failed to stat %s: %s!", src_path, strerror(errno));
+        close(src_fd);
+        return CBREW_FALSE;
+    }
+
+    const int dest_fd = open(dest_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, src_stat.st_mode & 07777);
+    if(dest_fd < 0)
+    {
+        CBREW_LOG_ERROR("Failed to create %s: %s!", dest_path, strerror(errno));
+        close(src_fd);
+        return CBREW_FALSE;
+    }
+
+    CbrewBool result = CBREW_TRUE;
+
+    // Both files share their blocks after cloning, which doesn't copy any data at all
+    if(ioctl(dest_fd, FICLONE, src_fd) != 0)
+    {
+        // Every fallback continues at the current offsets, since all of them advance the offsets of both files
+        off_t copied = 0;
+
+#ifdef SYS_copy_file_range
+        while(copied < src_stat.st_size)
+        {
+            const ssize_t bytes = syscall(SYS_copy_file_range, src_fd, NULL, dest_fd, NULL, (size_t) (src_stat.st_size - copied), 0);
+
+            if(bytes <= 0)
+                break;
+
+            copied += bytes;
+        }
+#endif
+
+        while(copied < src_stat.st_size)
+        {
+            const ssize_t bytes = sendfile(dest_fd, src_fd, NULL, (size_t) (src_stat.st_size - copied));
+
+            if(bytes <= 0)
+                break;
+
+            copied += bytes;
+        }
+
+        // The remaining data is read until the end of the file, since the size of some files is unknown, like the files inside /proc
+        {
+            const size_t buffer_size = 1024 * 1024;
+            char* buffer = malloc(buffer_size);
+
+            ssize_t bytes = 0;
+            while(result && (bytes = read(src_fd, buffer, buffer_size)) != 0)
+            {
+                if(bytes < 0)
+                {
+                    if(errno == EINTR)
+                        continue;
+
+                    CBREW_LOG_ERROR("Failed to read %s: %s!", src_path, strerror(errno));
+                    result = CBREW_FALSE;
+                    break;
+                }
+
+                for(ssize_t written = 0; written < bytes;)
+                {
+                    const ssize_t written_bytes = write(dest_fd, buffer + written, (size_t) (bytes - written));
+
+                    if(written_bytes < 0 && errno == EINTR)
+                        continue;
+
+                    if(written_bytes < 0)
+                    {
+                        CBREW_LOG_ERROR("Failed to write %s: %s!", dest_path, strerror(errno));
+                        result = CBREW_FALSE;
+                        break;
+                    }
+
+                    written += written_bytes;
+                }
+            }
+
+            free(buffer);
+        }
+    }
+
+    // The permissions passed to open are reduced by the umask
+    if(result && fchmod(dest_fd, src_stat.st_mode & 07777) != 0)
+    {
+        CBREW_LOG_ERROR("Failed to set the permissions of %s: %s!", dest_path, strerror(errno));
+        result = CBREW_FALSE;
+    }
+
+    const struct timespec times[2] = { src_stat.st_atim, src_stat.st_mtim };
+    if(result && futimens(dest_fd, times) != 0)
+    {
+        CBREW_LOG_ERROR("Failed to set the modification time of %s: %s!", dest_path, strerror(errno));
+        result = CBREW_FALSE;
+    }
+
+    // Errors of delayed writes are reported when closing the file
+    if(close(dest_fd) != 0 && result)
+    {
+        CBREW_LOG_ERROR("Failed to write %s: %s!", dest_path, strerror(errno));
+        result = CBREW_FALSE;
+    }
+
+    close(src_fd);
+
+    if(!result)
+        unlink(dest_path);
+
+    return result;
+}
+
+CbrewBool cbrew_file_link(const char* src_path, const char* link_path)
+{
+    CBREW_ASSERT(src_path != NULL);
+    CBREW_ASSERT(link_path != NULL);
+
+    return link(src_path, link_path) == 0;
+}
+
 char** cbrew_find_files(const char* dir, size_t* files_count)
 {
     CBREW_ASSERT(dir != NULL);
@@ -4,16 +4,28 @@ set SCRIPT_DIR=%~dp0
 set INSTALL_DIR=C:\cbrew
 set BIN_DIR=%INSTALL_DIR%\bin
 set INCLUDE_DIR=%INSTALL_DIR%\include\cbrew
+set LIB_DIR=%INSTALL_DIR%\lib
 
 :: Compiling cbrew
 echo Compiling cbrew...
 gcc -Wall -Wextra -Werror -O3 -I"%SCRIPT_DIR%include" "%SCRIPT_DIR%src\main.c" -o "%SCRIPT_DIR%cbrew"
 
+:: Compiling libcbrew
+echo Compiling libcbrew...
+gcc -Wall -Wextra -Werror -O3 -I"%SCRIPT_DIR%include" -c "%SCRIPT_DIR%src\cbrew.c" -o "%SCRIPT_DIR%cbrew.o"
+ar rcs "%SCRIPT_DIR%libcbrew.a" "%SCRIPT_DIR%cbrew.o"
+del "%SCRIPT_DIR%cbrew.o"
+
 :: Installing cbrew
 echo Installing cbrew...
 if not exist "%BIN_DIR%" mkdir "%BIN_DIR%"
 move /Y "%SCRIPT_DIR%cbrew.exe" "%BIN_DIR%" >nul
 
+:: Installing libcbrew
+echo Installing libcbrew...
+if not exist "%LIB_DIR%" mkdir "%LIB_DIR%"
+move /Y "%SCRIPT_DIR%libcbrew.a" "%LIB_DIR%" >nul
+
 :: Removing old cbrew headers
 if exist "%INCLUDE_DIR%" (
     echo Removing old cbrew headers...
@@ -5,16 +5,28 @@ set -e
 
 SCRIPT_DIR=$(dirname "$0")
 INCLUDE_DIR="/usr/local/include/cbrew/"
+LIB_DIR="/usr/local/lib/"
 CC=gcc
 
 # Compiling cbrew
 echo "Compiling cbrew..."
 $CC -Wall -Wextra -Werror -O3 -I$SCRIPT_DIR/include/ $SCRIPT_DIR/src/main.c -o$SCRIPT_DIR/cbrew
 
+# Compiling libcbrew
+echo "Compiling libcbrew..."
+$CC -Wall -Wextra -Werror -O3 -I$SCRIPT_DIR/include/ -c $SCRIPT_DIR/src/cbrew.c -o$SCRIPT_DIR/cbrew.o
+ar rcs $SCRIPT_DIR/libcbrew.a $SCRIPT_DIR/cbrew.o
+rm $SCRIPT_DIR/cbrew.o
+
 # Installing cbrew
 echo "Installing cbrew..."
 sudo mv $SCRIPT_DIR/cbrew /usr/local/bin/
 
+# Installing libcbrew
+echo "Installing libcbrew..."
+sudo mkdir -p "$LIB_DIR"
+sudo mv $SCRIPT_DIR/libcbrew.a "$LIB_DIR"
+
 # Removing old cbrew headers
 if [ -d "$INCLUDE_DIR" ]; then
     echo "Removing old cbrew headers..."
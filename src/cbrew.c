@@ -0,0 +1,2 @@
+#define CBREW_IMPLEMENTATION
+#include "cbrew.h"
@@ -1,6 +1,173 @@
 #define CBREW_IMPLEMENTATION
 #include "cbrew.h"
 
+#ifdef CBREW_PLATFORM_WINDOWS
+#define CBREW_LOCAL_EXECUTABLE ".cbrew" CBREW_PATH_SEPARATOR_STR "cbrew.exe"
+#else
+#define CBREW_LOCAL_EXECUTABLE ".cbrew" CBREW_PATH_SEPARATOR_STR "cbrew"
+#endif
+#define CBREW_LOCAL_DEP_FILE ".cbrew" CBREW_PATH_SEPARATOR_STR "cbrew.d"
+#define CBREW_LOCAL_SIGNATURE_FILE ".cbrew" CBREW_PATH_SEPARATOR_STR "cbrew.sig"
+
+static const char* get_compiler(void)
+{
+    const char* compiler = getenv("CBREW_CC");
+    if (compiler == NULL)
+    {
+        compiler = "gcc";
+    }
+
+    return compiler;
+}
+
+static void get_lib_filepath(char* lib_filepath)
+{
+    const char* lib_dir = getenv("CBREW_LIB_DIR");
+    if (lib_dir == NULL)
+    {
+#ifdef CBREW_PLATFORM_WINDOWS
+        lib_dir = "C:\\cbrew\\lib";
+#else
+        lib_dir = "/usr/local/lib";
+#endif
+    }
+
+    sprintf(lib_filepath, "%s%clibcbrew.a", lib_dir, CBREW_PATH_SEPARATOR);
+}
+
+static CbrewBool defines_cbrew_macros(const char* source)
+{
+    // Macros like CBREW_LOG_COMMANDS change the implementation, which is already compiled into libcbrew
+    for (const char* line = source; line != NULL; line = strchr(line, '\n'), line = line == NULL ? NULL : line + 1)
+    {
+        while (*line == ' ' || *line == '\t')
+        {
+            ++line;
+        }
+
+        if (*line++ != '#')
+        {
+            continue;
+        }
+
+        while (*line == ' ' || *line == '\t')
+        {
+            ++line;
+        }
+
+        if (strncmp(line, "define", 6) != 0 || (line[6] != ' ' && line[6] != '\t'))
+        {
+            continue;
+        }
+
+        line += 6;
+
+        while (*line == ' ' || *line == '\t')
+        {
+            ++line;
+        }
+
+        if (strncmp(line, "CBREW_", 6) == 0 && strncmp(line, "CBREW_IMPLEMENTATION", 20) != 0)
+        {
+            return CBREW_TRUE;
+        }
+    }
+
+    return CBREW_FALSE;
+}
+
+static CbrewBool can_use_lib(const char* lib_filepath)
+{
+    if (!cbrew_file_exists(lib_filepath))
+    {
+        return CBREW_FALSE;
+    }
+
+    char* source = cbrew_file_read("cbrew.c", NULL);
+    if (source == NULL)
+    {
+        return CBREW_FALSE;
+    }
+
+    CbrewBool result = !defines_cbrew_macros(source);
+
+    free(source);
+
+    return result;
+}
+
+static char* create_rebuild_command(void)
+{
+    char lib_filepath[CBREW_FILEPATH_MAX];
+    get_lib_filepath(lib_filepath);
+
+    // -MD instead of -MMD, since cbrew.h is usually found inside a system include directory
+    if (can_use_lib(lib_filepath))
+    {
+        return cbrew_create_str("%s -Wall -Wextra -O1 -DCBREW_DECLARATIONS_ONLY -MD -MF \"%s\" cbrew.c \"%s\" -o\"%s\"", get_compiler(), CBREW_LOCAL_DEP_FILE, lib_filepath, CBREW_LOCAL_EXECUTABLE);
+    }
+
+    return cbrew_create_str("%s -Wall -Wextra -O3 -MD -MF \"%s\" cbrew.c -o\"%s\"", get_compiler(), CBREW_LOCAL_DEP_FILE, CBREW_LOCAL_EXECUTABLE);
+}
+
+static char* create_signature(const char* command)
+{
+    // The compiler itself is part of the signature, so updating it rebuilds the local executable as well,
+    // even if CBREW_CC starts with a launcher or contains arguments
+    char compiler_program[CBREW_FILEPATH_MAX];
+    cbrew_compiler_program(compiler_program, get_compiler());
+
+    char compiler_filepath[CBREW_FILEPATH_MAX];
+    if (!cbrew_program_filepath(compiler_filepath, compiler_program))
+    {
+        strcpy(compiler_filepath, compiler_program);
+    }
+
+    // An updated libcbrew isn't part of the dependency file
+    char lib_filepath[CBREW_FILEPATH_MAX];
+    get_lib_filepath(lib_filepath);
+
+    const uint64_t lib_mtime = strstr(command, lib_filepath) != NULL ? cbrew_file_mtime(lib_filepath) : 0;
+
+    return cbrew_create_str("%s\n%s %llu\n%llu\n", command, compiler_filepath, (unsigned long long) cbrew_file_mtime(compiler_filepath), (unsigned long long) lib_mtime);
+}
+
+static CbrewBool is_outdated(void)
+{
+    if (!cbrew_file_exists(CBREW_LOCAL_EXECUTABLE))
+    {
+        return CBREW_TRUE;
+    }
+
+    // Neither the compiler nor the preprocessor are started here, only files are compared
+    char* command = create_rebuild_command();
+    char* signature = create_signature(command);
+    char* recorded_signature = cbrew_file_read(CBREW_LOCAL_SIGNATURE_FILE, NULL);
+
+    CbrewBool outdated = recorded_signature == NULL || strcmp(signature, recorded_signature) != 0;
+
+    free(command);
+    free(signature);
+    free(recorded_signature);
+
+    if (outdated)
+    {
+        return CBREW_TRUE;
+    }
+
+    char* rule = cbrew_file_read(CBREW_LOCAL_DEP_FILE, NULL);
+    if (rule == NULL)
+    {
+        return CBREW_TRUE;
+    }
+
+    outdated = !cbrew_file_is_newer_than_rule(CBREW_LOCAL_EXECUTABLE, rule, NULL);
+
+    free(rule);
+
+    return outdated;
+}
+
 static void rebuild(void)
 {
     if (!cbrew_dir_exists(".cbrew"))
@@ -11,16 +178,57 @@ static void rebuild(void)
         }
     }
 
-    const char* compiler = getenv("CBREW_CC");
-    if (compiler == NULL)
+    char* command = create_rebuild_command();
+
+    // A stale signature must not survive a failed rebuild
+    cbrew_file_delete(CBREW_LOCAL_SIGNATURE_FILE);
+
+    if (!cbrew_command("%s", command))
     {
-        compiler = "gcc";
+        free(command);
+        exit(EXIT_FAILURE);
     }
 
-    if (!cbrew_command("%s -Wall -Wextra -O3 cbrew.c -o.cbrew/cbrew", compiler))
+    char* signature = create_signature(command);
+
+    FILE* f = fopen(CBREW_LOCAL_SIGNATURE_FILE, "w");
+    if (f != NULL)
     {
-        exit(EXIT_FAILURE);
+        fputs(signature, f);
+        fclose(f);
+    }
+
+    free(signature);
+    free(command);
+}
+
+static int run(int argc, char** argv)
+{
+    if (is_outdated())
+    {
+        rebuild();
+    }
+
+    // Options are parsed by the local executable
+    CbrewStringBuilder sb;
+    memset(&sb, 0, sizeof(CbrewStringBuilder));
+
+    cbrew_string_builder_append(&sb, CBREW_LOCAL_EXECUTABLE);
+
+    // Arguments may contain quotes or characters that the shell would expand
+    for (int i = 1; i < argc; ++i)
+    {
+        cbrew_string_builder_append(&sb, " ");
+        cbrew_string_builder_append_argument(&sb, argv[i]);
     }
+
+    // The command line grows with the arguments, so it is run directly instead of being formatted into the fixed buffer of cbrew_command()
+    char* cmd = cbrew_string_builder_release(&sb);
+    CBREW_LOG_CMD("%s", cmd);
+    CbrewBool result = system(cmd) == EXIT_SUCCESS;
+    free(cmd);
+
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 static void init(void)
@@ -55,20 +263,25 @@ static void init(void)
 
 int main(int argc, char** argv)
 {
-    if (argc == 1)
+    if (argc == 1 || argv[1][0] == '-' || strcmp(argv[1], "build") == 0 || strcmp(argv[1], "clean") == 0 || strcmp(argv[1], "test") == 0 || strcmp(argv[1], "bench") == 0)
     {
-        if (!cbrew_file_exists(".cbrew/cbrew") || cbrew_first_file_is_older(".cbrew/cbrew", "cbrew.c"))
-        {
-            rebuild();
-        }
-
-        return cbrew_command(".cbrew" CBREW_PATH_SEPARATOR_STR "cbrew") == 0;
+        return run(argc, argv);
     }
 
     if (strcmp(argv[1], "init") == 0)
     {
         init();
     }
+    else if (strcmp(argv[1], "stats") == 0)
+    {
+        // The statistics are written by the local executable, but reading them doesn't require it
+        const int records_count = argc > 2 ? atoi(argv[2]) : 20;
+
+        if (!cbrew_stats_report(records_count > 0 ? (size_t) records_count : 20))
+        {
+            return EXIT_FAILURE;
+        }
+    }
     else
     {
         CBREW_LOG_ERROR("Invalid subcommand!");